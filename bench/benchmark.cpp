@@ -0,0 +1,218 @@
+#include "orderbook.h"
+#include "latency_probe.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+// Synthetic order-flow benchmark. Replays a parameterized mix of
+// add/cancel/modify commands with Zipf-distributed price offsets around a
+// moving touch and reports throughput plus latency percentiles per
+// operation type, so data-structure changes land with before/after numbers.
+//
+// Usage: benchmark [ops] [add%] [cancel%] [seed]
+// Remaining percentage after add/cancel goes to modify.
+
+namespace {
+
+struct BenchConfig
+{
+    size_t ops{1'000'000};
+    uint32_t add_pct{50};
+    uint32_t cancel_pct{40};
+    uint64_t seed{42};
+
+    // Of the adds: fraction routed as immediate-or-cancel types.
+    uint32_t fak_pct{5};
+    uint32_t fok_pct{5};
+
+    Price mid{1000};
+    size_t price_ticks{200};
+    double zipf_s{1.1};
+};
+
+// Zipf sampler over [0, ticks) via a precomputed CDF and binary search.
+class ZipfSampler
+{
+public:
+    ZipfSampler(size_t ticks, double s)
+    {
+        m_cdf.reserve(ticks);
+        double sum = 0.0;
+        for (size_t i = 0; i < ticks; ++i) {
+            sum += 1.0 / std::pow(static_cast<double>(i + 1), s);
+            m_cdf.push_back(sum);
+        }
+        for (auto& v : m_cdf) {
+            v /= sum;
+        }
+    }
+
+    size_t operator()(std::mt19937_64& rng) const
+    {
+        const double u = std::uniform_real_distribution<double>{0.0, 1.0}(rng);
+        const auto it = std::lower_bound(m_cdf.begin(), m_cdf.end(), u);
+        return static_cast<size_t>(it - m_cdf.begin());
+    }
+
+private:
+    std::vector<double> m_cdf;
+};
+
+struct LatencyStats
+{
+    std::vector<uint32_t> samples;
+
+    void record(std::chrono::nanoseconds elapsed)
+    {
+        samples.push_back(static_cast<uint32_t>(elapsed.count()));
+    }
+
+    uint32_t percentile(double p) const
+    {
+        if (samples.empty()) {
+            return 0;
+        }
+        const auto rank = static_cast<size_t>(p * (samples.size() - 1));
+        return samples[rank];
+    }
+};
+
+void report(const char* name, LatencyStats& stats, std::chrono::nanoseconds total)
+{
+    std::sort(stats.samples.begin(), stats.samples.end());
+
+    const double seconds = std::chrono::duration<double>(total).count();
+    const double mops = seconds > 0.0 ? stats.samples.size() / seconds / 1e6 : 0.0;
+
+    std::printf("%-7s %9zu ops  %7.3f Mops/s  p50=%6u  p90=%6u  p99=%6u  p99.9=%6u  max=%6u ns\n",
+                name, stats.samples.size(), mops,
+                stats.percentile(0.50), stats.percentile(0.90), stats.percentile(0.99),
+                stats.percentile(0.999), stats.samples.empty() ? 0 : stats.samples.back());
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    BenchConfig config;
+
+    if (argc > 1) {
+        config.ops = std::stoull(argv[1]);
+    }
+    if (argc > 2) {
+        config.add_pct = static_cast<uint32_t>(std::stoul(argv[2]));
+    }
+    if (argc > 3) {
+        config.cancel_pct = static_cast<uint32_t>(std::stoul(argv[3]));
+    }
+    if (argc > 4) {
+        config.seed = std::stoull(argv[4]);
+    }
+
+    if (config.add_pct + config.cancel_pct > 100) {
+        std::fprintf(stderr, "add%% + cancel%% must not exceed 100\n");
+        return 1;
+    }
+
+    std::mt19937_64 rng{config.seed};
+    const ZipfSampler zipf{config.price_ticks, config.zipf_s};
+
+    Orderbook book;
+    std::vector<Trade> trades;
+    trades.reserve(1024);
+
+    std::vector<Order::Id> live;
+    live.reserve(config.ops);
+    Order::Id next_id = 1;
+
+    LatencyStats add_stats, cancel_stats, modify_stats;
+    std::chrono::nanoseconds add_total{0}, cancel_total{0}, modify_total{0};
+
+    using clock = std::chrono::steady_clock;
+
+    for (size_t i = 0; i < config.ops; ++i) {
+        const auto roll = std::uniform_int_distribution<uint32_t>{0, 99}(rng);
+
+        if (roll < config.add_pct || live.empty()) {
+            const auto side = (rng() & 1) ? Side::BUY : Side::SELL;
+
+            // Offset -2..ticks-3 from the touch: small offsets dominate and
+            // negative ones cross the book to exercise match().
+            const auto offset = static_cast<Price>(zipf(rng)) - 2;
+            const auto price = side == Side::BUY ? config.mid - offset : config.mid + offset;
+
+            auto type = Order::Type::GTC;
+            const auto type_roll = std::uniform_int_distribution<uint32_t>{0, 99}(rng);
+            if (type_roll < config.fak_pct) {
+                type = Order::Type::FAK;
+            } else if (type_roll < config.fak_pct + config.fok_pct) {
+                type = Order::Type::FOK;
+            }
+
+            const Order order = {
+                .id = next_id,
+                .type = type,
+                .remainder = std::uniform_int_distribution<Quantity>{1, 100}(rng),
+                .side = side,
+                .price = price
+            };
+
+            trades.clear();
+            const auto start = clock::now();
+            book.add(order, trades);
+            const auto elapsed = clock::now() - start;
+
+            add_stats.record(elapsed);
+            add_total += elapsed;
+
+            if (type == Order::Type::GTC) {
+                live.push_back(next_id);
+            }
+            ++next_id;
+        } else {
+            const auto pick = std::uniform_int_distribution<size_t>{0, live.size() - 1}(rng);
+            const auto id = live[pick];
+
+            if (roll < config.add_pct + config.cancel_pct) {
+                const auto start = clock::now();
+                book.cancel(id);
+                const auto elapsed = clock::now() - start;
+
+                cancel_stats.record(elapsed);
+                cancel_total += elapsed;
+
+                live[pick] = live.back();
+                live.pop_back();
+            } else {
+                const Change change = {
+                    .remainder = std::uniform_int_distribution<Quantity>{1, 100}(rng),
+                    .side = (rng() & 1) ? Side::BUY : Side::SELL,
+                    .price = config.mid + static_cast<Price>(zipf(rng))
+                };
+
+                trades.clear();
+                const auto start = clock::now();
+                book.modify(id, change, trades);
+                const auto elapsed = clock::now() - start;
+
+                modify_stats.record(elapsed);
+                modify_total += elapsed;
+            }
+        }
+    }
+
+    report("add", add_stats, add_total);
+    report("cancel", cancel_stats, cancel_total);
+    report("modify", modify_stats, modify_total);
+
+#ifdef ORDERBOOK_LATENCY_PROBES
+    latency::report();
+#endif
+
+    return 0;
+}
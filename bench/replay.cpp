@@ -0,0 +1,189 @@
+#include "orderbook.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Deterministic replay of captured production flow. Reads a recorded
+// command file, drives the book through add/cancel/modify either at the
+// original inter-arrival times or at max speed, and folds every emitted
+// Trade plus the final book snapshot into one checksum — so a
+// data-structure change can be A/B'd against the exact burst that hurt
+// us, with a one-word proof that behavior is unchanged.
+//
+// Usage: replay <capture-file> [--paced] [--expect <checksum-hex>]
+//
+// Capture format: a fixed header followed by TimedCommand records, in
+// arrival order, timestamps in nanoseconds from capture start.
+
+namespace {
+
+constexpr uint64_t kCaptureMagic = 0x574f4c464b4f4f42;  // "BOOKFLOW"
+constexpr uint32_t kCaptureVersion = 2;  // v2: Order carries arrival_ns
+
+struct CaptureHeader
+{
+    uint64_t magic{0};
+    uint32_t version{0};
+    uint32_t reserved{0};
+    uint64_t count{0};
+};
+
+struct TimedCommand
+{
+    uint64_t timestamp_ns{0};
+    Command command{};
+};
+
+// FNV-1a over raw bytes; endian- and layout-stable enough for A/B runs
+// of the same build tree on the same hardware, which is what we compare.
+class Checksum
+{
+public:
+    void fold(const void* data, size_t size)
+    {
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            m_hash ^= bytes[i];
+            m_hash *= 0x100000001b3ull;
+        }
+    }
+
+    uint64_t value() const { return m_hash; }
+
+private:
+    uint64_t m_hash{0xcbf29ce484222325ull};
+};
+
+std::vector<TimedCommand> loadCapture(const std::string& path)
+{
+    std::ifstream in{path, std::ios::binary};
+    if (!in) {
+        std::fprintf(stderr, "replay: cannot open %s\n", path.c_str());
+        std::exit(EXIT_FAILURE);
+    }
+
+    CaptureHeader header;
+    in.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!in || header.magic != kCaptureMagic || header.version != kCaptureVersion) {
+        std::fprintf(stderr, "replay: %s is not a version-%u capture\n", path.c_str(), kCaptureVersion);
+        std::exit(EXIT_FAILURE);
+    }
+
+    std::vector<TimedCommand> records(header.count);
+    in.read(reinterpret_cast<char*>(records.data()), static_cast<std::streamsize>(header.count * sizeof(TimedCommand)));
+    if (!in) {
+        std::fprintf(stderr, "replay: %s is truncated\n", path.c_str());
+        std::exit(EXIT_FAILURE);
+    }
+
+    return records;
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: replay <capture-file> [--paced] [--expect <checksum-hex>]\n");
+        return EXIT_FAILURE;
+    }
+
+    const std::string path = argv[1];
+    bool paced = false;
+    uint64_t expected = 0;
+    bool verify = false;
+
+    for (int i = 2; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--paced") == 0) {
+            paced = true;
+        } else if (std::strcmp(argv[i], "--expect") == 0 && i + 1 < argc) {
+            expected = std::strtoull(argv[++i], nullptr, 16);
+            verify = true;
+        }
+    }
+
+    const auto records = loadCapture(path);
+
+    Orderbook book;
+    Checksum checksum;
+    std::vector<Trade> trades;
+    trades.reserve(256);
+
+    const auto start = std::chrono::steady_clock::now();
+
+    for (const auto& record : records) {
+        if (paced) {
+            std::this_thread::sleep_until(start + std::chrono::nanoseconds{record.timestamp_ns});
+        }
+
+        trades.clear();
+
+        switch (record.command.kind) {
+        case Command::Kind::ADD: {
+            // Captures that predate arrival stamping get the record's
+            // capture time, so the final-state checksum stays run-stable.
+            auto order = record.command.order;
+            if (order.arrival_ns == 0) {
+                order.arrival_ns = std::max<uint64_t>(record.timestamp_ns, 1);
+            }
+            book.add(order, trades);
+            break;
+        }
+        case Command::Kind::CANCEL:
+            book.cancel(record.command.order_id);
+            break;
+        case Command::Kind::MODIFY:
+            book.modify(record.command.order_id, record.command.change, trades);
+            break;
+        case Command::Kind::UNKNOWN:
+            break;
+        }
+
+        // Fold per-leg functional fields only; resting_ns is wall-clock
+        // derived and would differ between otherwise identical runs.
+        const auto foldLeg = [&checksum](const TradeInfo& info) {
+            checksum.fold(&info.order_id, sizeof(info.order_id));
+            checksum.fold(&info.price, sizeof(info.price));
+            checksum.fold(&info.quantity, sizeof(info.quantity));
+            checksum.fold(&info.aggressor, sizeof(info.aggressor));
+        };
+
+        for (const auto& trade : trades) {
+            foldLeg(trade.bid_info);
+            foldLeg(trade.ask_info);
+        }
+    }
+
+    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count();
+
+    // Final book state enters the checksum through the snapshot image, so
+    // two runs agree only if every resting order, priority and reserve
+    // quantity agrees.
+    std::stringstream image;
+    book.snapshot(image);
+    const auto state = image.str();
+    checksum.fold(state.data(), state.size());
+
+    const double mops = elapsed > 0 ? static_cast<double>(records.size()) * 1e3 / static_cast<double>(elapsed) : 0.0;
+    std::printf("replayed %zu commands in %.3f ms (%.3f Mops/s)%s\n",
+                records.size(), static_cast<double>(elapsed) / 1e6, mops, paced ? " [paced]" : "");
+    std::printf("checksum %016llx\n", static_cast<unsigned long long>(checksum.value()));
+
+    if (verify && checksum.value() != expected) {
+        std::fprintf(stderr, "replay: checksum mismatch (expected %016llx)\n",
+                     static_cast<unsigned long long>(expected));
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
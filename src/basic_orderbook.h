@@ -0,0 +1,1522 @@
+#pragma once
+
+#include "types/order.h"
+#include "types/change.h"
+#include "types/command.h"
+#include "types/trade.h"
+#include "types/book_event.h"
+#include "order_pool.h"
+#include "order_map.h"
+#include "price_ladder.h"
+#include "numa_arena.h"
+#include "top_of_book.h"
+#include "broadcast_ring.h"
+#include "journal.h"
+#include "trade_reporter.h"
+#include "mbp_feed.h"
+#include "latency_probe.h"
+
+#include <algorithm>
+#include <chrono>
+#include <format>
+#include <istream>
+#include <ostream>
+#include <span>
+#include <vector>
+#include <optional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <atomic>
+#include <condition_variable>
+
+using BookEventRing = BroadcastRing<BookEvent>;
+
+// Compile-time feature selection for BasicOrderbook. Each flag removes a
+// whole subsystem from the instantiation: disabled order types lose their
+// admission branches and helpers, kFullFillOrders also drops the ladder's
+// Fenwick upkeep, and kGoodForDayOrders drops the expiry list and the
+// prune thread.
+struct AllFeatures
+{
+    static constexpr bool kMarketOrders = true;      // MAR conversion
+    static constexpr bool kImmediateOrders = true;   // FAK gating and sweep
+    static constexpr bool kFullFillOrders = true;    // FOK admissibility
+    static constexpr bool kGoodForDayOrders = true;  // GFD expiry + prune thread
+    static constexpr bool kStopOrders = true;        // STOP/STOP_LIMIT triggers
+};
+
+// GTC/FAK-only book for flows that never carry the exotic types.
+struct CoreFeatures
+{
+    static constexpr bool kMarketOrders = false;
+    static constexpr bool kImmediateOrders = true;
+    static constexpr bool kFullFillOrders = false;
+    static constexpr bool kGoodForDayOrders = false;
+    static constexpr bool kStopOrders = false;
+};
+
+// Admission controls applied in addImpl before an order is journaled or
+// rested; zero disables a check.
+struct AdmissionLimits
+{
+    // Reject limit orders further than this many ticks from the touch
+    // (the opposite best, falling back to the same side's best).
+    Price max_ticks_from_touch{0};
+
+    // Reject orders joining a level that already holds this many orders.
+    uint32_t max_orders_per_level{0};
+};
+
+// What happens when the two orders about to cross belong to the same
+// participant.
+enum class SelfMatchPolicy
+{
+    NONE = 0,
+    CANCEL_RESTING = 1,
+    CANCEL_AGGRESSOR = 2,
+    DECREMENT = 3
+};
+
+template <class Features = AllFeatures>
+class BasicOrderbook
+{
+public:
+    // When constructed over a journal, existing records are replayed to
+    // rebuild the book, then every accepted command is appended. When an
+    // event ring is supplied, trades and level updates are broadcast into
+    // it inline from the matching path. When a reporter is supplied, each
+    // entry point also hands its fills off for asynchronous reporting, so
+    // the caller's critical path ends at the ring write. When an MBP feed
+    // is supplied, each operation flushes one coalesced, sequence-numbered
+    // increment covering the levels it touched. When an arena is supplied,
+    // the pool, id table and ladders are carved from it, so on a pinned
+    // core all per-book storage is NUMA-local; the arena must outlive the
+    // book. The self-match policy and admission limits are constructor
+    // parameters because replay happens here: a journaled session must be
+    // recovered under the configuration it was written with, or the
+    // rebuilt book diverges.
+    explicit BasicOrderbook(Journal* journal = nullptr, BookEventRing* events = nullptr,
+                            TradeReporter* reporter = nullptr, MbpFeed* feed = nullptr,
+                            NumaArena* arena = nullptr,
+                            SelfMatchPolicy smp_policy = SelfMatchPolicy::NONE,
+                            const AdmissionLimits& limits = {})
+        : m_arena{arena}
+        , m_pool{OrderPool::kDefaultCapacity, arena}
+        , m_orders{OrderMap::kDefaultCapacity, arena}
+        , m_bids{arena}
+        , m_asks{arena}
+        , m_smp_policy{smp_policy}
+        , m_limits{limits}
+        , m_reporter{reporter}
+        , m_feed{feed}
+        , m_orders_prune_thread{makePruneThread()}
+    {
+        m_touched.reserve(MbpUpdate::kMaxEntries);
+        if (journal) {
+            std::scoped_lock lock{m_orders_mutex};
+
+            std::vector<Trade> trades;
+            journal->replay([&](const Command& command) {
+                trades.clear();
+                applyImpl(command, trades);
+            });
+
+            m_journal = journal;
+        }
+
+        // Attached after any replay: consumers get the live stream, not a
+        // re-broadcast of recovered history.
+        m_events = events;
+    }
+
+    ~BasicOrderbook()
+    {
+        {
+            // The store must happen under the mutex, or the notify can slip
+            // into the window between the prune thread's predicate check and
+            // its wait.
+            std::scoped_lock lock{m_orders_mutex};
+            m_shutdown.store(true, std::memory_order_release);
+        }
+        m_shutdown_cv.notify_one();
+
+        if (m_orders_prune_thread.joinable()) {
+            m_orders_prune_thread.join();
+        }
+    }
+
+    // Scoped bulk-load mode for snapshot recovery: while the guard is
+    // alive, adds skip per-order matching, FAK/FOK gating and quote
+    // publication; destruction runs one uncrossing pass and publishes.
+    class BulkLoad
+    {
+    public:
+        BulkLoad(BasicOrderbook& book, std::vector<Trade>& trades)
+            : m_book{book}
+            , m_trades{trades}
+        {
+            std::scoped_lock lock{m_book.m_orders_mutex};
+            m_book.m_bulk_loading = true;
+        }
+
+        ~BulkLoad()
+        {
+            std::scoped_lock lock{m_book.m_orders_mutex};
+            m_book.m_bulk_loading = false;
+            const auto first = m_trades.size();
+            m_book.match(m_trades);
+            m_book.publishTopOfBook();
+            m_book.reportTrades(m_trades, first);
+            m_book.flushFeed();
+        }
+
+        BulkLoad(const BulkLoad&) = delete;
+        BulkLoad& operator=(const BulkLoad&) = delete;
+
+    private:
+        BasicOrderbook& m_book;
+        std::vector<Trade>& m_trades;
+    };
+
+    // All trade-producing entry points append into a caller-supplied buffer
+    // so a session can keep one preallocated vector alive across calls;
+    // quiet adds (the common case) never allocate. add returns a
+    // generation-checked handle to the resting order, or an invalid one
+    // when nothing rested (rejected, fully filled, swept FAK, armed stop);
+    // the handle lets later cancels and modifies skip the id lookup and
+    // makes stale references resolve to nothing instead of a reused slot.
+    OrderHandle add(const Order& order, std::vector<Trade>& trades)
+    {
+        ORDERBOOK_PROBE_START(lock);
+        std::scoped_lock lock{m_orders_mutex};
+        ORDERBOOK_PROBE_STOP(lock, latency::Probe::ADD_LOCK);
+
+        const auto first = trades.size();
+        const auto handle = addImpl(order, trades);
+        reportTrades(trades, first);
+        flushFeed();
+        return handle;
+    }
+
+    void cancel(Order::Id order_id)
+    {
+        ORDERBOOK_PROBE_START(lock);
+        std::scoped_lock lock{m_orders_mutex};
+        ORDERBOOK_PROBE_STOP(lock, latency::Probe::CANCEL_LOCK);
+
+        cancelImpl(order_id);
+        flushFeed();
+    }
+
+    // Stale handles (order filled, cancelled or expired since) are no-ops.
+    void cancel(OrderHandle handle)
+    {
+        ORDERBOOK_PROBE_START(lock);
+        std::scoped_lock lock{m_orders_mutex};
+        ORDERBOOK_PROBE_STOP(lock, latency::Probe::CANCEL_LOCK);
+
+        const auto index = m_pool.resolve(handle);
+        if (index == OrderPool::kInvalidIndex) {
+            return;
+        }
+
+        cancelImpl(m_pool.at(index).order.id);
+        flushFeed();
+    }
+
+    void modify(Order::Id order_id, const Change& change, std::vector<Trade>& trades)
+    {
+        ORDERBOOK_PROBE_START(lock);
+        std::scoped_lock lock{m_orders_mutex};
+        ORDERBOOK_PROBE_STOP(lock, latency::Probe::MODIFY_LOCK);
+
+        const auto first = trades.size();
+        modifyImpl(order_id, change, trades);
+        reportTrades(trades, first);
+        flushFeed();
+    }
+
+    void modify(OrderHandle handle, const Change& change, std::vector<Trade>& trades)
+    {
+        ORDERBOOK_PROBE_START(lock);
+        std::scoped_lock lock{m_orders_mutex};
+        ORDERBOOK_PROBE_STOP(lock, latency::Probe::MODIFY_LOCK);
+
+        const auto index = m_pool.resolve(handle);
+        if (index == OrderPool::kInvalidIndex) {
+            return;
+        }
+
+        const auto first = trades.size();
+        modifyImpl(m_pool.at(index).order.id, change, trades);
+        reportTrades(trades, first);
+        flushFeed();
+    }
+
+    // Replays a whole decoded packet under one lock acquisition.
+    void apply(std::span<const Command> commands, std::vector<Trade>& trades)
+    {
+        std::scoped_lock lock{m_orders_mutex};
+
+        const auto first = trades.size();
+        for (const auto& command : commands) {
+            applyImpl(command, trades);
+        }
+        reportTrades(trades, first);
+        flushFeed();
+    }
+
+    // Reconfigures a live book going forward. Books recovering from a
+    // journal take their limits through the constructor instead, so replay
+    // runs under what the journal was written with.
+    void setAdmissionLimits(const AdmissionLimits& limits)
+    {
+        std::scoped_lock lock{m_orders_mutex};
+        m_limits = limits;
+    }
+
+    // Reconfigures a live book going forward. Books recovering from a
+    // journal take their policy through the constructor instead, so replay
+    // runs under what the journal was written with.
+    void setSelfMatchPolicy(SelfMatchPolicy policy)
+    {
+        std::scoped_lock lock{m_orders_mutex};
+        m_smp_policy = policy;
+    }
+
+    // Wait-free reads of the published top-N snapshot; never touch the
+    // book mutex and never block the matching thread.
+    TopOfBook topOfBook() const
+    {
+        return m_top_cache.read();
+    }
+
+    // Price-weighted cost for an aggressor on `side` to sweep `quantity`
+    // best-first off the opposite ladder; nullopt when the book cannot
+    // fill it. Answered from the ladders' incremental prefix sums, not a
+    // walk over the levels.
+    std::optional<Cost> sweepCost(Side side, Quantity quantity) const
+    {
+        std::scoped_lock lock{m_orders_mutex};
+        return side == Side::BUY ? m_asks.sweepCost(quantity) : m_bids.sweepCost(quantity);
+    }
+
+    // Best-first aggregates of up to `levels` price levels on one side,
+    // for queries deeper than the fixed-depth topOfBook snapshot.
+    std::vector<TopOfBook::Level> depth(Side side, size_t levels) const
+    {
+        std::vector<TopOfBook::Level> out;
+
+        if (levels == 0) {
+            return out;
+        }
+
+        out.reserve(levels);
+
+        std::scoped_lock lock{m_orders_mutex};
+
+        const auto collect = [&](Price price, const auto& level) {
+            out.push_back({.price = price, .quantity = level.quantity, .count = level.count});
+            return out.size() < levels;
+        };
+
+        if (side == Side::BUY) {
+            m_bids.forEachLevel(collect);
+        } else {
+            m_asks.forEachLevel(collect);
+        }
+
+        return out;
+    }
+
+    // Writes a compact, versioned binary image of the book: a fixed header
+    // followed by raw Order records, bids then asks, each side emitted in
+    // priority order (best level first, FIFO within a level), then any
+    // armed stops (buy then sell trigger books, in trigger order).
+    void snapshot(std::ostream& out) const
+    {
+        std::scoped_lock lock{m_orders_mutex};
+
+        SnapshotHeader header{
+            .magic = kSnapshotMagic,
+            .version = kSnapshotVersion,
+            .bid_count = sideOrderCount(m_bids),
+            .ask_count = sideOrderCount(m_asks),
+            .buy_stop_count = stopOrderCount(m_buy_stops),
+            .sell_stop_count = stopOrderCount(m_sell_stops)
+        };
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        writeSide(out, m_bids);
+        writeSide(out, m_asks);
+        writeStops(out, m_buy_stops);
+        writeStops(out, m_sell_stops);
+    }
+
+    // Rebuilds the book from a snapshot image, replacing current state.
+    // Records arrive in priority order, so this is one sequential pass of
+    // direct pool/ladder/map insertion — no matching, gating or journaling
+    // per order.
+    void restore(std::istream& in)
+    {
+        SnapshotHeader header{};
+        in.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+        if (!in || header.magic != kSnapshotMagic) {
+            throw std::runtime_error("Orderbook snapshot is malformed.");
+        }
+
+        if (header.version != kSnapshotVersion) {
+            throw std::runtime_error(std::format("Orderbook snapshot has unsupported version {}.", header.version));
+        }
+
+        std::scoped_lock lock{m_orders_mutex};
+
+        m_pool = OrderPool{OrderPool::kDefaultCapacity, m_arena};
+        m_orders = OrderMap{OrderMap::kDefaultCapacity, m_arena};
+        m_bids = Bids{m_arena};
+        m_asks = Asks{m_arena};
+        m_gfd_head = OrderPool::kInvalidIndex;
+        m_gfd_tail = OrderPool::kInvalidIndex;
+        m_bid_participants.clear();
+        m_ask_participants.clear();
+        m_buy_stops.clear();
+        m_sell_stops.clear();
+
+        const auto total = header.bid_count + header.ask_count;
+        for (uint64_t i = 0; i < total; ++i) {
+            Order order;
+            in.read(reinterpret_cast<char*>(&order), sizeof(order));
+            if (!in) {
+                throw std::runtime_error("Orderbook snapshot is truncated.");
+            }
+
+            const auto index = m_pool.allocate(order);
+
+            if (order.side == Side::BUY) {
+                m_bids.insert(m_pool, order.price, index);
+            } else {
+                m_asks.insert(m_pool, order.price, index);
+            }
+
+            m_orders.insert(order.id, index);
+
+            trackGFD(index);
+            trackParticipant(order);
+        }
+
+        const auto stop_total = header.buy_stop_count + header.sell_stop_count;
+        for (uint64_t i = 0; i < stop_total; ++i) {
+            Order order;
+            in.read(reinterpret_cast<char*>(&order), sizeof(order));
+            if (!in) {
+                throw std::runtime_error("Orderbook snapshot is truncated.");
+            }
+
+            if (order.side == Side::BUY) {
+                m_buy_stops[order.stop_price].push_back(order);
+            } else {
+                m_sell_stops[order.stop_price].push_back(order);
+            }
+        }
+
+        publishTopOfBook();
+    }
+
+    std::optional<Price> bestPrice(Side side) const
+    {
+        const auto top = m_top_cache.read();
+
+        if (side == Side::BUY && top.bid_depth > 0) {
+            return top.bids[0].price;
+        }
+
+        if (side == Side::SELL && top.ask_depth > 0) {
+            return top.asks[0].price;
+        }
+
+        return std::nullopt;
+    }
+
+private:
+    // The engine drains its submission ring on a single matching thread and
+    // drives the *Impl entry points directly, taking the lock per batch.
+    friend class OrderbookEngine;
+
+    using Bids = PriceLadder<Side::BUY, Features::kFullFillOrders>;
+    using Asks = PriceLadder<Side::SELL, Features::kFullFillOrders>;
+
+    struct SnapshotHeader
+    {
+        uint64_t magic{0};
+        uint32_t version{0};
+        uint32_t reserved{0};
+        uint64_t bid_count{0};
+        uint64_t ask_count{0};
+        uint64_t buy_stop_count{0};
+        uint64_t sell_stop_count{0};
+    };
+
+    static constexpr uint64_t kSnapshotMagic = 0x50414e534b4f4f42;  // "BOOKSNAP"
+    static constexpr uint32_t kSnapshotVersion = 3;  // v2: Order carries arrival_ns; v3: armed stops in the image
+
+    template <class Ladder>
+    uint64_t sideOrderCount(const Ladder& ladder) const
+    {
+        uint64_t count = 0;
+        ladder.forEachLevel([&](Price, const typename Ladder::Level& level) {
+            count += level.count;
+            return true;
+        });
+        return count;
+    }
+
+    template <class Ladder>
+    void writeSide(std::ostream& out, const Ladder& ladder) const
+    {
+        ladder.forEachLevel([&](Price, const typename Ladder::Level& level) {
+            for (auto i = level.queue.head; i != OrderPool::kInvalidIndex; i = m_pool.at(i).next) {
+                const auto& order = m_pool.at(i).order;
+                out.write(reinterpret_cast<const char*>(&order), sizeof(order));
+            }
+            return true;
+        });
+    }
+
+    template <class StopMap>
+    static uint64_t stopOrderCount(const StopMap& stops)
+    {
+        uint64_t count = 0;
+        for (const auto& [price, armed] : stops) {
+            count += armed.size();
+        }
+        return count;
+    }
+
+    template <class StopMap>
+    static void writeStops(std::ostream& out, const StopMap& stops)
+    {
+        for (const auto& [price, armed] : stops) {
+            for (const auto& order : armed) {
+                out.write(reinterpret_cast<const char*>(&order), sizeof(order));
+            }
+        }
+    }
+
+    std::thread makePruneThread()
+    {
+        if constexpr (Features::kGoodForDayOrders) {
+            return std::thread{[this] { pruneGFD(); }};
+        } else {
+            return {};
+        }
+    }
+
+    void pruneGFD()
+    {
+        while (true) {
+            const auto next = nextPruneTime();
+
+            {
+                std::unique_lock lock{m_orders_mutex};
+                m_shutdown_cv.wait_until(lock, next, [&]() { return m_shutdown.load(std::memory_order_acquire); });
+                if (m_shutdown.load(std::memory_order_acquire)) {
+                    return;
+                }
+            }
+
+            expireGFDs();
+        }
+    }
+
+    void expireGFDs()
+    {
+        while (true) {
+            std::scoped_lock lock{m_orders_mutex};
+
+            size_t cancelled = 0;
+            while (cancelled < kPruneChunk && m_gfd_head != OrderPool::kInvalidIndex) {
+                cancelImpl(m_pool.at(m_gfd_head).order.id);
+                ++cancelled;
+            }
+
+            flushFeed();
+
+            if (m_gfd_head == OrderPool::kInvalidIndex) {
+                return;
+            }
+
+            // Drop the lock between chunks so matching can interleave with a
+            // large close-of-day expiry.
+        }
+    }
+
+    void trackGFD(OrderPool::Index index)
+    {
+        if constexpr (!Features::kGoodForDayOrders) {
+            (void)index;
+            return;
+        } else {
+            auto& node = m_pool.at(index);
+            if (node.order.type != Order::Type::GFD) {
+                return;
+            }
+
+            node.gfd_prev = m_gfd_tail;
+            node.gfd_next = OrderPool::kInvalidIndex;
+
+            if (m_gfd_tail == OrderPool::kInvalidIndex) {
+                m_gfd_head = index;
+            } else {
+                m_pool.at(m_gfd_tail).gfd_next = index;
+            }
+
+            m_gfd_tail = index;
+        }
+    }
+
+    void untrackGFD(OrderPool::Index index)
+    {
+        if constexpr (!Features::kGoodForDayOrders) {
+            (void)index;
+            return;
+        } else {
+            auto& node = m_pool.at(index);
+            if (node.order.type != Order::Type::GFD) {
+                return;
+            }
+
+            if (node.gfd_prev == OrderPool::kInvalidIndex) {
+                m_gfd_head = node.gfd_next;
+            } else {
+                m_pool.at(node.gfd_prev).gfd_next = node.gfd_next;
+            }
+
+            if (node.gfd_next == OrderPool::kInvalidIndex) {
+                m_gfd_tail = node.gfd_prev;
+            } else {
+                m_pool.at(node.gfd_next).gfd_prev = node.gfd_prev;
+            }
+        }
+    }
+
+    std::chrono::system_clock::time_point nextPruneTime() const
+    {
+        using namespace std::chrono;
+        const auto now_c = system_clock::to_time_t(system_clock::now());
+
+        std::tm t{};
+        localtime_r(&now_c, &t);
+
+        if (t.tm_hour >= static_cast<int>(kPruneHour)) {
+            t.tm_mday += 1;
+        }
+
+        t.tm_hour = kPruneHour;
+        t.tm_min = 0;
+        t.tm_sec = 0;
+
+        return system_clock::from_time_t(mktime(&t));
+    }
+
+    static uint64_t arrivalNow()
+    {
+        using namespace std::chrono;
+        return static_cast<uint64_t>(duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count());
+    }
+
+    OrderHandle addImpl(const Order& order, std::vector<Trade>& trades)
+    {
+        ORDERBOOK_PROBE_SCOPE(latency::Probe::ADD_PATH);
+
+        if (m_orders.contains(order.id)) {
+            return {};
+        }
+
+        if (order.side == Side::UNKNOWN) {
+            throw std::logic_error(std::format("Order ({}) cannot be added to the orderbook.", order.id));
+        }
+
+        Order incoming = order;
+
+        // Arrival stamp for match telemetry, taken once at admission while
+        // the order is already in cache. Pre-stamped records (journal
+        // replay, stop injection) keep their original time.
+        if (incoming.arrival_ns == 0) {
+            incoming.arrival_ns = arrivalNow();
+        }
+
+        if constexpr (Features::kStopOrders) {
+            // Stops rest in the trigger maps, not on the ladders; they are
+            // journaled at admission and injected through this same path
+            // (unjournaled) once a print reaches the stop price, so replay
+            // re-arms and re-triggers them deterministically.
+            if (incoming.type == Order::Type::STOP || incoming.type == Order::Type::STOP_LIMIT) {
+                journalAppend({.kind = Command::Kind::ADD, .order = incoming});
+
+                if (incoming.side == Side::BUY) {
+                    m_buy_stops[incoming.stop_price].push_back(incoming);
+                } else {
+                    m_sell_stops[incoming.stop_price].push_back(incoming);
+                }
+
+                // The market may already be through the stop.
+                triggerStops(trades);
+                return {};
+            }
+        }
+
+        // Market conversions land at the worst opposite price by design,
+        // so the tick band would reject exactly the orders meant to cross
+        // the spread; they skip that check (the per-level cap still holds).
+        bool band_exempt = false;
+
+        if constexpr (Features::kMarketOrders) {
+            if (incoming.type == Order::Type::MAR) {
+                const auto gtc_order = processMAR(incoming);
+                if (!gtc_order) {
+                    return {};
+                }
+
+                incoming = *gtc_order;
+                band_exempt = true;
+            }
+        }
+
+        // Icebergs enter with remainder = total quantity; split off the
+        // reserve so only the display portion rests visibly. Replayed
+        // records arrive pre-split and pass through unchanged.
+        if (incoming.type == Order::Type::ICEBERG && incoming.display > 0 && incoming.display < incoming.remainder) {
+            incoming.hidden = incoming.remainder - incoming.display;
+            incoming.remainder = incoming.display;
+        }
+
+        if (!m_bulk_loading) {
+            if (!admissible(incoming, band_exempt)) {
+                return {};
+            }
+
+            if constexpr (Features::kImmediateOrders) {
+                if (incoming.type == Order::Type::FAK && !canMatch(incoming.side, incoming.price)) {
+                    return {};
+                }
+            }
+
+            if constexpr (Features::kFullFillOrders) {
+                if (incoming.type == Order::Type::FOK && !canFullyFill(incoming.side, incoming.price, incoming.remainder)) {
+                    return {};
+                }
+            }
+        }
+
+        journalAppend({.kind = Command::Kind::ADD, .order = incoming});
+
+        const auto index = m_pool.allocate(incoming);
+
+        if (incoming.side == Side::BUY) {
+            m_bids.insert(m_pool, incoming.price, index);
+        } else {
+            m_asks.insert(m_pool, incoming.price, index);
+        }
+
+        m_orders.insert(incoming.id, index);
+
+        trackGFD(index);
+        trackParticipant(incoming);
+
+        // Issued before matching: if the order fills (or is swept) below,
+        // the slot's generation moves on and the handle comes back stale.
+        const auto handle = m_pool.handleFor(index);
+
+        publishLevelEvent(incoming.side, incoming.price);
+
+        if (m_bulk_loading) {
+            return handle;
+        }
+
+        // One hash probe decides whether matching needs the per-iteration
+        // self-match check at all: most aggressors have nothing resting on
+        // the other side.
+        const bool check_self_match = m_smp_policy != SelfMatchPolicy::NONE &&
+            incoming.participant != 0 && hasOppositeResting(incoming.participant, incoming.side);
+
+        match(trades, incoming.id, check_self_match);
+
+        if constexpr (Features::kStopOrders) {
+            triggerStops(trades);
+        }
+
+        publishTopOfBook();
+
+        return m_pool.resolve(handle) == index ? handle : OrderHandle{};
+    }
+
+    void cancelImpl(Order::Id order_id)
+    {
+        const auto* found = m_orders.find(order_id);
+        if (!found) {
+            if constexpr (Features::kStopOrders) {
+                // Armed stops rest in the trigger books, not on the
+                // ladders; pulling one is just a journaled removal.
+                if (findArmedStop(order_id)) {
+                    journalAppend({.kind = Command::Kind::CANCEL, .order_id = order_id});
+                    eraseArmedStop(order_id);
+                }
+            }
+            return;
+        }
+
+        // Journal before touching book state: append throws when the
+        // preallocated file is exhausted, and a half-applied cancel (id
+        // gone from the map, order still resting) is unrecoverable. Costs
+        // a second probe sequence over a combined erase.
+        journalAppend({.kind = Command::Kind::CANCEL, .order_id = order_id});
+
+        const auto index = *found;
+        const auto order = m_pool.at(index).order;
+        m_orders.erase(order_id);
+
+        if (order.side == Side::BUY) {
+            m_bids.remove(m_pool, order.price, index);
+        } else if (order.side == Side::SELL) {
+            m_asks.remove(m_pool, order.price, index);
+        }
+
+        untrackGFD(index);
+        untrackParticipant(order);
+        m_pool.release(index);
+
+        publishLevelEvent(order.side, order.price);
+
+        publishTopOfBook();
+    }
+
+    void modifyImpl(Order::Id order_id, const Change& change, std::vector<Trade>& trades)
+    {
+        const auto* found = m_orders.find(order_id);
+        if (!found) {
+            if constexpr (Features::kStopOrders) {
+                // Amend an armed stop in place: new quantity and (for
+                // STOP_LIMIT) limit price. The trigger level and side
+                // stay put; re-arming elsewhere is cancel + re-add.
+                if (auto* stop = findArmedStop(order_id)) {
+                    journalAppend({.kind = Command::Kind::MODIFY, .order_id = order_id, .change = change});
+                    stop->remainder = change.remainder;
+                    stop->price = change.price;
+                }
+            }
+            return;
+        }
+
+        // Validate before journaling: a record that throws mid-rebuild
+        // would poison every subsequent replay.
+        if (change.side == Side::UNKNOWN) {
+            throw std::logic_error(std::format("Order ({}) cannot be modified in the orderbook.", order_id));
+        }
+
+        journalAppend({.kind = Command::Kind::MODIFY, .order_id = order_id, .change = change});
+
+        const auto index = *found;
+        auto& order = m_pool.at(index).order;
+
+        // Fast amend: same side and price with a pure quantity reduction
+        // keeps queue position and cannot cross, so patch the order and its
+        // level aggregate in place instead of cancel + re-add + match.
+        // Icebergs take the rebuild path: their remainder is only the
+        // visible slice, and change.remainder is the new total, which the
+        // re-add splits against the reserve.
+        if (order.hidden == 0 &&
+            change.side == order.side && change.price == order.price &&
+            change.remainder > 0 && change.remainder <= order.remainder) {
+            const auto delta = order.remainder - change.remainder;
+            order.remainder = change.remainder;
+
+            if (delta > 0) {
+                if (order.side == Side::BUY) {
+                    m_bids.reduce(order.price, delta);
+                } else {
+                    m_asks.reduce(order.price, delta);
+                }
+
+                publishLevelEvent(order.side, order.price);
+
+                publishTopOfBook();
+            }
+
+            return;
+        }
+
+        // change.remainder is the new total; addImpl re-splits the iceberg
+        // reserve off the carried display size.
+        auto new_order = Order {
+            .id = order_id,
+            // Ownership survives the rebuild, or self-match prevention
+            // would stop applying to amended orders.
+            .participant = order.participant,
+            .type = order.type,
+            .remainder = change.remainder,
+            .display = order.display,
+            .side = change.side,
+            .price = change.price,
+            // Telemetry keeps the original arrival: resting time measures
+            // the order's lifetime, not its position in the new queue.
+            .arrival_ns = order.arrival_ns
+        };
+
+        // The modify record above already covers the rebuild; pause
+        // journaling so the nested cancel/add do not double-log.
+        JournalPause pause{*this};
+        cancelImpl(order_id);
+        addImpl(new_order, trades);
+    }
+
+    void applyImpl(const Command& command, std::vector<Trade>& trades)
+    {
+        switch (command.kind) {
+        case Command::Kind::ADD:
+            addImpl(command.order, trades);
+            break;
+        case Command::Kind::CANCEL:
+            cancelImpl(command.order_id);
+            break;
+        case Command::Kind::MODIFY:
+            modifyImpl(command.order_id, command.change, trades);
+            break;
+        case Command::Kind::UNKNOWN:
+            break;
+        }
+    }
+
+    // Emits one sequence-numbered MBP increment with the final state of
+    // every level the finished operation touched.
+    void flushFeed()
+    {
+        if (!m_feed || m_touched.empty()) {
+            return;
+        }
+
+        std::vector<MbpUpdate::Entry> entries;
+        entries.reserve(m_touched.size());
+
+        for (const auto& [side, price] : m_touched) {
+            MbpUpdate::Entry entry{.side = side, .price = price};
+
+            if (side == Side::BUY) {
+                const auto level = m_bids.levelOrEmpty(price);
+                entry.quantity = level.quantity;
+                entry.count = level.count;
+            } else {
+                const auto level = m_asks.levelOrEmpty(price);
+                entry.quantity = level.quantity;
+                entry.count = level.count;
+            }
+
+            entries.push_back(entry);
+        }
+
+        m_feed->publish(entries);
+        m_touched.clear();
+    }
+
+    // Hands the trades appended by this call (from `first` onward) to the
+    // reporter; one lock-free ring write each.
+    void reportTrades(const std::vector<Trade>& trades, size_t first)
+    {
+        if (!m_reporter) {
+            return;
+        }
+
+        for (size_t i = first; i < trades.size(); ++i) {
+            m_reporter->submit(trades[i]);
+        }
+    }
+
+    // Scoped suppression of journaling for nested operations derived from
+    // already-journaled state. Restores the previous value so pauses nest,
+    // and survives exceptions: a throw mid-rebuild must not leave
+    // journaling disabled for everything after it.
+    class JournalPause
+    {
+    public:
+        explicit JournalPause(BasicOrderbook& book)
+            : m_book{book}
+            , m_previous{book.m_journal_paused}
+        {
+            m_book.m_journal_paused = true;
+        }
+
+        ~JournalPause()
+        {
+            m_book.m_journal_paused = m_previous;
+        }
+
+        JournalPause(const JournalPause&) = delete;
+        JournalPause& operator=(const JournalPause&) = delete;
+
+    private:
+        BasicOrderbook& m_book;
+        bool m_previous;
+    };
+
+    void journalAppend(const Command& command)
+    {
+        if (m_journal && !m_journal_paused) {
+            m_journal->append(command);
+        }
+    }
+
+    void publishTradeEvent(const Trade& trade)
+    {
+        if (m_events) {
+            m_events->publish({.kind = BookEvent::Kind::TRADE, .trade = trade});
+        }
+    }
+
+    void publishLevelEvent(Side side, Price price)
+    {
+        // Feed coalescing: remember the touched level once; the final
+        // aggregate is read at flush, after the whole cascade settled.
+        if (m_feed) {
+            const auto seen = std::find(m_touched.begin(), m_touched.end(), std::pair{side, price});
+            if (seen == m_touched.end()) {
+                m_touched.push_back({side, price});
+            }
+        }
+
+        if (!m_events) {
+            return;
+        }
+
+        Quantity quantity = 0;
+        uint32_t count = 0;
+
+        if (side == Side::BUY) {
+            const auto level = m_bids.levelOrEmpty(price);
+            quantity = level.quantity;
+            count = level.count;
+        } else {
+            const auto level = m_asks.levelOrEmpty(price);
+            quantity = level.quantity;
+            count = level.count;
+        }
+
+        m_events->publish({
+            .kind = BookEvent::Kind::LEVEL_UPDATE,
+            .side = side,
+            .price = price,
+            .quantity = quantity,
+            .count = count
+        });
+    }
+
+    void publishTopOfBook()
+    {
+        TopOfBook top;
+
+        m_bids.forEachLevel([&](Price price, const typename Bids::Level& level) {
+            top.bids[top.bid_depth++] = {.price = price, .quantity = level.quantity, .count = level.count};
+            return top.bid_depth < TopOfBook::kDepth;
+        });
+
+        m_asks.forEachLevel([&](Price price, const typename Asks::Level& level) {
+            top.asks[top.ask_depth++] = {.price = price, .quantity = level.quantity, .count = level.count};
+            return top.ask_depth < TopOfBook::kDepth;
+        });
+
+        m_top_cache.publish(top);
+    }
+
+    void match(std::vector<Trade>& trades, Order::Id aggressor = 0, bool check_self_match = false)
+    {
+        while (!m_asks.empty() && !m_bids.empty()) {
+            if (m_asks.bestPrice() > m_bids.bestPrice()) {
+                break;
+            }
+
+            if (check_self_match) {
+                const auto& bid = m_pool.at(m_bids.bestQueue().head).order;
+                const auto& ask = m_pool.at(m_asks.bestQueue().head).order;
+
+                if (bid.participant != 0 && bid.participant == ask.participant) {
+                    resolveSelfMatch(bid.id, ask.id, aggressor, bid.remainder, ask.remainder);
+                    continue;
+                }
+            }
+
+            const auto trade = matchTop(aggressor);
+            trades.push_back(std::move(trade));
+        }
+
+        if constexpr (Features::kImmediateOrders) {
+            cancelFAKs();
+        }
+    }
+
+    Trade matchTop(Order::Id aggressor = 0)
+    {
+        ORDERBOOK_PROBE_SCOPE(latency::Probe::MATCH_ITERATION);
+
+        auto& bids = m_bids.bestQueue();
+        auto& asks = m_asks.bestQueue();
+
+        const auto bid_index = bids.head;
+        const auto ask_index = asks.head;
+
+        auto& bid = m_pool.at(bid_index).order;
+        auto& ask = m_pool.at(ask_index).order;
+
+        const auto quantity = std::min(bid.remainder, ask.remainder);
+
+        bid.fill(quantity);
+        ask.fill(quantity);
+
+        // Resting times and aggressor flags are filled in here, where both
+        // orders' cache lines are already hot — no side-table lookup per
+        // fill downstream. Unstamped legs (pre-telemetry snapshots) report
+        // zero.
+        const auto now = arrivalNow();
+
+        Trade trade = {
+            .bid_info = {
+                .order_id = bid.id,
+                .price = bid.price,
+                .quantity = quantity,
+                .resting_ns = bid.arrival_ns > 0 ? now - bid.arrival_ns : 0,
+                .aggressor = bid.id == aggressor
+            },
+            .ask_info = {
+                .order_id = ask.id,
+                .price = ask.price,
+                .quantity = quantity,
+                .resting_ns = ask.arrival_ns > 0 ? now - ask.arrival_ns : 0,
+                .aggressor = ask.id == aggressor
+            }
+        };
+
+        m_bids.reduce(trade.bid_info.price, quantity);
+        m_asks.reduce(trade.ask_info.price, quantity);
+
+        if (bid.filled()) {
+            if (bid.hidden > 0) {
+                replenishIceberg(m_bids, bid_index);
+            } else {
+                m_bids.remove(m_pool, trade.bid_info.price, bid_index);
+                m_orders.erase(trade.bid_info.order_id);
+                untrackGFD(bid_index);
+                untrackParticipant(bid);
+                m_pool.release(bid_index);
+            }
+        }
+
+        if (ask.filled()) {
+            if (ask.hidden > 0) {
+                replenishIceberg(m_asks, ask_index);
+            } else {
+                m_asks.remove(m_pool, trade.ask_info.price, ask_index);
+                m_orders.erase(trade.ask_info.order_id);
+                untrackGFD(ask_index);
+                untrackParticipant(ask);
+                m_pool.release(ask_index);
+            }
+        }
+
+        // Highest and lowest prints of the session, for stop triggering:
+        // crossed books report both legs' prices, so buy stops arm off the
+        // bid leg and sell stops off the ask leg.
+        m_last_high_print = trade.bid_info.price;
+        m_last_low_print = trade.ask_info.price;
+        m_has_traded = true;
+
+        publishTradeEvent(trade);
+        publishLevelEvent(Side::BUY, trade.bid_info.price);
+        publishLevelEvent(Side::SELL, trade.ask_info.price);
+
+        return trade;
+    }
+
+    // Rolls reserve quantity into the visible remainder and sends the order
+    // to the back of its level's queue: one aggregate bump and two
+    // intrusive-list splices — no map traffic, no allocation.
+    template <class Ladder>
+    void replenishIceberg(Ladder& ladder, OrderPool::Index index)
+    {
+        auto& order = m_pool.at(index).order;
+
+        const auto refill = std::min(order.display, order.hidden);
+        order.hidden -= refill;
+        order.remainder = refill;
+
+        ladder.increase(order.price, refill);
+
+        auto& queue = ladder.bestQueue();
+        queue.erase(m_pool, index);
+        queue.pushBack(m_pool, index);
+    }
+
+    // Pops every armed stop whose price the last print reached and feeds
+    // it back through addImpl as a market (STOP) or GTC limit (STOP_LIMIT)
+    // order. The reentrancy guard flattens the cascade: injected orders
+    // trade, update the last prints, and the outer loop re-checks until no
+    // stop fires. The O(1) fast path is one begin() comparison per side.
+    // Id lookups over the trigger books walk them directly: armed
+    // populations are small and cancels of stops are rare, so a second
+    // index is not worth carrying on the hot path.
+    Order* findArmedStop(Order::Id order_id)
+    {
+        if (auto* order = findArmedStopIn(m_buy_stops, order_id)) {
+            return order;
+        }
+        return findArmedStopIn(m_sell_stops, order_id);
+    }
+
+    template <class StopMap>
+    static Order* findArmedStopIn(StopMap& stops, Order::Id order_id)
+    {
+        for (auto& [price, armed] : stops) {
+            for (auto& order : armed) {
+                if (order.id == order_id) {
+                    return &order;
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    bool eraseArmedStop(Order::Id order_id)
+    {
+        return eraseArmedStopFrom(m_buy_stops, order_id) || eraseArmedStopFrom(m_sell_stops, order_id);
+    }
+
+    template <class StopMap>
+    static bool eraseArmedStopFrom(StopMap& stops, Order::Id order_id)
+    {
+        for (auto it = stops.begin(); it != stops.end(); ++it) {
+            auto& armed = it->second;
+            for (auto armed_it = armed.begin(); armed_it != armed.end(); ++armed_it) {
+                if (armed_it->id == order_id) {
+                    armed.erase(armed_it);
+                    if (armed.empty()) {
+                        stops.erase(it);
+                    }
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    void triggerStops(std::vector<Trade>& trades)
+    {
+        if (m_triggering || !m_has_traded) {
+            return;
+        }
+
+        m_triggering = true;
+
+        while (true) {
+            std::vector<Order> fired;
+
+            while (!m_buy_stops.empty() && m_buy_stops.begin()->first <= m_last_high_print) {
+                auto& armed = m_buy_stops.begin()->second;
+                fired.insert(fired.end(), armed.begin(), armed.end());
+                m_buy_stops.erase(m_buy_stops.begin());
+            }
+
+            while (!m_sell_stops.empty() && m_sell_stops.begin()->first >= m_last_low_print) {
+                auto& armed = m_sell_stops.begin()->second;
+                fired.insert(fired.end(), armed.begin(), armed.end());
+                m_sell_stops.erase(m_sell_stops.begin());
+            }
+
+            if (fired.empty()) {
+                break;
+            }
+
+            JournalPause pause{*this};
+
+            for (auto& order : fired) {
+                if (order.type == Order::Type::STOP) {
+                    order.type = Order::Type::MAR;
+                } else {
+                    order.type = Order::Type::GTC;
+                }
+
+                addImpl(order, trades);
+            }
+        }
+
+        m_triggering = false;
+    }
+
+    // Applies the configured policy to a same-participant cross. The
+    // resulting cancels stay unjournaled: they are derived from replayable
+    // state, so replay under the same policy reproduces them. DECREMENT
+    // shrinks both orders by the overlap without printing a trade.
+    void resolveSelfMatch(Order::Id bid_id, Order::Id ask_id, Order::Id aggressor,
+                          Quantity bid_remainder, Quantity ask_remainder)
+    {
+        JournalPause pause{*this};
+
+        switch (m_smp_policy) {
+        case SelfMatchPolicy::CANCEL_RESTING:
+            cancelImpl(bid_id == aggressor ? ask_id : bid_id);
+            break;
+        case SelfMatchPolicy::CANCEL_AGGRESSOR:
+            cancelImpl(ask_id == aggressor ? ask_id : bid_id);
+            break;
+        case SelfMatchPolicy::DECREMENT: {
+            const auto overlap = std::min(bid_remainder, ask_remainder);
+            decrementOrCancel(bid_id, bid_remainder, overlap);
+            decrementOrCancel(ask_id, ask_remainder, overlap);
+            break;
+        }
+        case SelfMatchPolicy::NONE:
+            break;
+        }
+    }
+
+    void decrementOrCancel(Order::Id order_id, Quantity remainder, Quantity overlap)
+    {
+        if (remainder <= overlap) {
+            cancelImpl(order_id);
+            return;
+        }
+
+        const auto* found = m_orders.find(order_id);
+        auto& order = m_pool.at(*found).order;
+        order.remainder -= overlap;
+
+        if (order.side == Side::BUY) {
+            m_bids.reduce(order.price, overlap);
+        } else {
+            m_asks.reduce(order.price, overlap);
+        }
+
+        publishLevelEvent(order.side, order.price);
+    }
+
+    // Fat-finger containment: keeps far-from-touch levels out of the
+    // ladders and caps how deep a single level's queue can grow, so the
+    // book's working set stays inside the dense region the matcher visits.
+    bool admissible(const Order& order, bool band_exempt = false) const
+    {
+        if (!band_exempt && m_limits.max_ticks_from_touch > 0) {
+            std::optional<Price> touch;
+
+            if (order.side == Side::BUY) {
+                touch = m_asks.empty() ? (m_bids.empty() ? std::nullopt : std::optional{m_bids.bestPrice()})
+                                       : std::optional{m_asks.bestPrice()};
+            } else {
+                touch = m_bids.empty() ? (m_asks.empty() ? std::nullopt : std::optional{m_asks.bestPrice()})
+                                       : std::optional{m_bids.bestPrice()};
+            }
+
+            if (touch) {
+                const auto distance = order.price > *touch ? order.price - *touch : *touch - order.price;
+                if (distance > m_limits.max_ticks_from_touch) {
+                    return false;
+                }
+            }
+        }
+
+        if (m_limits.max_orders_per_level > 0) {
+            const auto count = order.side == Side::BUY ? m_bids.levelOrEmpty(order.price).count
+                                                       : m_asks.levelOrEmpty(order.price).count;
+            if (count >= m_limits.max_orders_per_level) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void trackParticipant(const Order& order)
+    {
+        if (order.participant == 0) {
+            return;
+        }
+
+        auto& counts = order.side == Side::BUY ? m_bid_participants : m_ask_participants;
+        ++counts[order.participant];
+    }
+
+    void untrackParticipant(const Order& order)
+    {
+        if (order.participant == 0) {
+            return;
+        }
+
+        auto& counts = order.side == Side::BUY ? m_bid_participants : m_ask_participants;
+        const auto it = counts.find(order.participant);
+        if (it != counts.end() && --it->second == 0) {
+            counts.erase(it);
+        }
+    }
+
+    bool hasOppositeResting(Participant participant, Side side) const
+    {
+        const auto& counts = side == Side::BUY ? m_ask_participants : m_bid_participants;
+        return counts.contains(participant);
+    }
+
+    void cancelFAKs()
+    {
+        if (!m_bids.empty()) {
+            const auto& bids = m_bids.bestQueue();
+            if (m_pool.at(bids.head).order.type == Order::Type::FAK) {
+                cancelImpl(m_pool.at(bids.head).order.id);
+            }
+        }
+
+        if (!m_asks.empty()) {
+            const auto& asks = m_asks.bestQueue();
+            if (m_pool.at(asks.head).order.type == Order::Type::FAK) {
+                cancelImpl(m_pool.at(asks.head).order.id);
+            }
+        }
+    }
+
+    std::optional<Order> processMAR(const Order& order) const
+    {
+        if (order.type != Order::Type::MAR) {
+            return std::nullopt;
+        }
+
+        Price worst_price{0};
+
+        if (order.side == Side::BUY && !m_asks.empty()) {
+            worst_price = m_asks.worstPrice();
+        } else if (order.side == Side::SELL && !m_bids.empty()) {
+            worst_price = m_bids.worstPrice();
+        } else {
+            return std::nullopt;
+        }
+
+        auto gtc_order = order;
+        gtc_order.type = Order::Type::GTC;
+        gtc_order.price = worst_price;
+
+        return gtc_order;
+    }
+
+    bool canMatch(Side side, Price price) const
+    {
+        if (side == Side::BUY) {
+            if (m_asks.empty()) {
+                return false;
+            }
+
+            const auto best_ask = m_asks.bestPrice();
+            return best_ask <= price;
+        }
+
+        if (side == Side::SELL) {
+            if (m_bids.empty()) {
+                return false;
+            }
+
+            const auto best_bid = m_bids.bestPrice();
+            return best_bid >= price;
+        }
+
+        return false;
+    }
+
+    bool canFullyFill(Side side, Price price, Quantity quantity) const
+    {
+        if (side == Side::UNKNOWN || !canMatch(side, price)) {
+            return false;
+        }
+
+        if (side == Side::BUY) {
+            return canFullyFillBid(price, quantity);
+        } else {
+            return canFullyFillAsk(price, quantity);
+        }
+    }
+
+    bool canFullyFillBid(Price price, Quantity quantity) const
+    {
+        if (quantity == 0) {
+            return true;
+        }
+
+        if (m_asks.totalQuantity() < quantity) {
+            return false;
+        }
+
+        return m_asks.quantityBetterOrEqual(price) >= quantity;
+    }
+
+    bool canFullyFillAsk(Price price, Quantity quantity) const
+    {
+        if (quantity == 0) {
+            return true;
+        }
+
+        if (m_bids.totalQuantity() < quantity) {
+            return false;
+        }
+
+        return m_bids.quantityBetterOrEqual(price) >= quantity;
+    }
+
+private:
+    NumaArena* m_arena{nullptr};
+
+    OrderPool m_pool;
+    OrderMap m_orders;
+
+    Bids m_bids;
+    Asks m_asks;
+
+    // Intrusive list over pool nodes holding only resting GFD orders, so
+    // daily expiry touches just the affected orders instead of scanning
+    // m_orders.
+    OrderPool::Index m_gfd_head{OrderPool::kInvalidIndex};
+    OrderPool::Index m_gfd_tail{OrderPool::kInvalidIndex};
+
+    TopOfBookCache m_top_cache;
+
+    // Armed stops keyed by stop price, best-triggering level at begin():
+    // buy stops fire low-to-high against the high print, sell stops
+    // high-to-low against the low print.
+    std::map<Price, std::vector<Order>> m_buy_stops;
+    std::map<Price, std::vector<Order>, std::greater<Price>> m_sell_stops;
+    Price m_last_high_print{0};
+    Price m_last_low_print{0};
+    bool m_has_traded{false};
+    bool m_triggering{false};
+
+    // Resting order counts per participant and side; one probe tells an
+    // aggressor whether self-match checks can be skipped entirely.
+    std::unordered_map<Participant, uint32_t> m_bid_participants;
+    std::unordered_map<Participant, uint32_t> m_ask_participants;
+    SelfMatchPolicy m_smp_policy{SelfMatchPolicy::NONE};
+    AdmissionLimits m_limits;
+
+    BookEventRing* m_events{nullptr};
+    TradeReporter* m_reporter{nullptr};
+    MbpFeed* m_feed{nullptr};
+
+    // Levels touched by the operation in flight, deduplicated on insert
+    // and drained by flushFeed.
+    std::vector<std::pair<Side, Price>> m_touched;
+
+    Journal* m_journal{nullptr};
+    bool m_journal_paused{false};
+    bool m_bulk_loading{false};
+
+    static constexpr uint32_t kPruneHour = 16;
+    static constexpr size_t kPruneChunk = 1024;
+
+    mutable std::mutex m_orders_mutex;
+    std::condition_variable m_shutdown_cv;
+    std::atomic<bool> m_shutdown{false};
+
+    // Must be the last member: the prune thread uses the mutex, condition
+    // variable and shutdown flag from the moment it starts.
+    std::thread m_orders_prune_thread;
+};
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Single-producer broadcast ring: one writer publishes into fixed slots,
+// any number of readers poll independently with their own cursors and
+// never consume — every reader sees every record. Each slot carries a
+// seqlock-style version (odd while the writer is copying in, then twice
+// the one-based record index), so a reader can detect both "not written
+// yet" and "writer lapped me" without any shared reader state.
+//
+// The writer never blocks on readers; a reader that falls more than one
+// capacity behind loses records and resynchronizes at the oldest record
+// still resident, counting what it skipped.
+template <class T>
+class BroadcastRing
+{
+public:
+    explicit BroadcastRing(size_t capacity)
+        : m_slots(std::bit_ceil(capacity))
+        , m_mask{m_slots.size() - 1}
+    {
+    }
+
+    BroadcastRing(const BroadcastRing&) = delete;
+    BroadcastRing& operator=(const BroadcastRing&) = delete;
+
+    // Writer side; single-threaded by contract.
+    void publish(const T& value)
+    {
+        const auto index = m_count.load(std::memory_order_relaxed);
+        auto& slot = m_slots[index & m_mask];
+
+        slot.version.store(2 * (index + 1) - 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.value = value;
+        slot.version.store(2 * (index + 1), std::memory_order_release);
+
+        m_count.store(index + 1, std::memory_order_release);
+    }
+
+    size_t count() const
+    {
+        return m_count.load(std::memory_order_acquire);
+    }
+
+    class Reader
+    {
+    public:
+        explicit Reader(const BroadcastRing& ring) : m_ring{&ring} {}
+
+        // Copies the next record out, skipping ahead past anything the
+        // writer has already overwritten. Returns false when caught up.
+        bool poll(T& out)
+        {
+            while (true) {
+                const auto published = m_ring->count();
+                if (m_cursor >= published) {
+                    return false;
+                }
+
+                // Lapped: the oldest record still guaranteed resident is
+                // one capacity behind the write point.
+                if (published - m_cursor > m_ring->m_mask + 1) {
+                    const auto oldest = published - (m_ring->m_mask + 1);
+                    m_lost += oldest - m_cursor;
+                    m_cursor = oldest;
+                }
+
+                const auto& slot = m_ring->m_slots[m_cursor & m_ring->m_mask];
+                const auto expected = 2 * (m_cursor + 1);
+
+                if (slot.version.load(std::memory_order_acquire) != expected) {
+                    // Overwritten between the count check and here.
+                    ++m_lost;
+                    ++m_cursor;
+                    continue;
+                }
+
+                out = slot.value;
+                std::atomic_thread_fence(std::memory_order_acquire);
+
+                if (slot.version.load(std::memory_order_relaxed) != expected) {
+                    ++m_lost;
+                    ++m_cursor;
+                    continue;
+                }
+
+                ++m_cursor;
+                return true;
+            }
+        }
+
+        // Records skipped because this reader fell behind the writer.
+        uint64_t lost() const { return m_lost; }
+
+    private:
+        const BroadcastRing* m_ring;
+        uint64_t m_cursor{0};
+        uint64_t m_lost{0};
+    };
+
+private:
+    struct Slot
+    {
+        std::atomic<uint64_t> version{0};
+        T value{};
+    };
+
+    std::vector<Slot> m_slots;
+    size_t m_mask;
+
+    alignas(64) std::atomic<uint64_t> m_count{0};
+};
@@ -0,0 +1,77 @@
+#include "journal.h"
+
+#include <format>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+Journal::Journal(const std::string& path, size_t max_records)
+    : m_max_records{max_records}
+{
+    m_fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (m_fd < 0) {
+        throw std::runtime_error(std::format("Journal ({}) cannot be opened.", path));
+    }
+
+    m_map_size = sizeof(Header) + max_records * sizeof(Command);
+    if (::ftruncate(m_fd, static_cast<off_t>(m_map_size)) != 0) {
+        ::close(m_fd);
+        throw std::runtime_error(std::format("Journal ({}) cannot be preallocated.", path));
+    }
+
+    m_map = ::mmap(nullptr, m_map_size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+    if (m_map == MAP_FAILED) {
+        ::close(m_fd);
+        throw std::runtime_error(std::format("Journal ({}) cannot be mapped.", path));
+    }
+
+    m_header = static_cast<Header*>(m_map);
+    m_records = reinterpret_cast<Command*>(static_cast<char*>(m_map) + sizeof(Header));
+
+    if (m_header->magic != kMagic) {
+        // Fresh (or foreign) file: start an empty journal.
+        *m_header = Header{.magic = kMagic, .version = kVersion};
+    } else if (m_header->version != kVersion) {
+        ::munmap(m_map, m_map_size);
+        ::close(m_fd);
+        throw std::runtime_error(std::format("Journal ({}) has unsupported version.", path));
+    }
+
+    if (m_header->count > m_max_records) {
+        m_header->count = m_max_records;
+    }
+}
+
+Journal::~Journal()
+{
+    if (m_map != nullptr) {
+        ::msync(m_map, m_map_size, MS_SYNC);
+        ::munmap(m_map, m_map_size);
+    }
+
+    if (m_fd >= 0) {
+        ::close(m_fd);
+    }
+}
+
+void Journal::append(const Command& command)
+{
+    if (m_header->count >= m_max_records) {
+        throw std::runtime_error("Journal is full.");
+    }
+
+    m_records[m_header->count] = command;
+    ++m_header->count;
+}
+
+size_t Journal::size() const
+{
+    return m_header->count;
+}
+
+const Command& Journal::at(size_t index) const
+{
+    return m_records[index];
+}
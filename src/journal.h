@@ -0,0 +1,60 @@
+#pragma once
+
+#include "types/command.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+// Write-ahead journal of accepted commands backed by a memory-mapped,
+// preallocated file. Appends are a struct copy plus a counter bump — no
+// syscalls on the hot path; the kernel writes pages back asynchronously.
+// On startup a book constructed over an existing journal replays it to
+// rebuild its state at memory speed.
+class Journal
+{
+    static_assert(std::is_trivially_copyable_v<Command>);
+
+public:
+    explicit Journal(const std::string& path, size_t max_records = kDefaultMaxRecords);
+    ~Journal();
+
+    Journal(const Journal&) = delete;
+    Journal& operator=(const Journal&) = delete;
+
+    // Throws std::runtime_error when the preallocated file is exhausted.
+    void append(const Command& command);
+
+    size_t size() const;
+    const Command& at(size_t index) const;
+
+    template <class F>
+    void replay(F&& f) const
+    {
+        const auto count = size();
+        for (size_t i = 0; i < count; ++i) {
+            f(at(i));
+        }
+    }
+
+private:
+    struct Header
+    {
+        uint64_t magic{0};
+        uint32_t version{0};
+        uint32_t reserved{0};
+        uint64_t count{0};
+    };
+
+    static constexpr uint64_t kMagic = 0x4c4e524a4b4f4f42;  // "BOOKJRNL"
+    static constexpr uint32_t kVersion = 2;  // v2: Order carries arrival_ns
+    static constexpr size_t kDefaultMaxRecords = 1 << 20;
+
+    Header* m_header{nullptr};
+    Command* m_records{nullptr};
+    void* m_map{nullptr};
+    size_t m_map_size{0};
+    size_t m_max_records{0};
+    int m_fd{-1};
+};
@@ -0,0 +1,124 @@
+#ifdef ORDERBOOK_LATENCY_PROBES
+
+#include "latency_probe.h"
+
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace latency {
+
+namespace {
+
+struct ThreadHistograms
+{
+    std::array<Histogram, kProbeCount> histograms{};
+};
+
+std::mutex g_registry_mutex;
+std::vector<std::unique_ptr<ThreadHistograms>>& registry()
+{
+    static std::vector<std::unique_ptr<ThreadHistograms>> instance;
+    return instance;
+}
+
+ThreadHistograms& localHistograms()
+{
+    thread_local ThreadHistograms* local = [] {
+        auto owned = std::make_unique<ThreadHistograms>();
+        auto* raw = owned.get();
+
+        std::scoped_lock lock{g_registry_mutex};
+        registry().push_back(std::move(owned));
+        return raw;
+    }();
+
+    return *local;
+}
+
+const char* probeName(Probe probe)
+{
+    switch (probe) {
+    case Probe::ADD_PATH: return "add_path";
+    case Probe::MATCH_ITERATION: return "match_iteration";
+    case Probe::ADD_LOCK: return "add_lock";
+    case Probe::CANCEL_LOCK: return "cancel_lock";
+    case Probe::MODIFY_LOCK: return "modify_lock";
+    case Probe::COUNT: break;
+    }
+    return "unknown";
+}
+
+uint64_t bucketPercentile(const std::array<uint64_t, kBuckets>& counts, double p)
+{
+    uint64_t total = 0;
+    for (const auto c : counts) {
+        total += c;
+    }
+
+    if (total == 0) {
+        return 0;
+    }
+
+    const auto rank = static_cast<uint64_t>(p * total);
+    uint64_t seen = 0;
+
+    for (size_t bucket = 0; bucket < kBuckets; ++bucket) {
+        seen += counts[bucket];
+        if (seen > rank) {
+            // Upper bound of the bucket, in cycles.
+            return bucket == 0 ? 0 : (uint64_t{1} << bucket) - 1;
+        }
+    }
+
+    return UINT64_MAX;
+}
+
+}  // namespace
+
+Histogram& histogram(Probe probe)
+{
+    return localHistograms().histograms[static_cast<size_t>(probe)];
+}
+
+Snapshot snapshot()
+{
+    Snapshot result;
+
+    std::scoped_lock lock{g_registry_mutex};
+    for (const auto& thread_histograms : registry()) {
+        for (size_t p = 0; p < kProbeCount; ++p) {
+            for (size_t bucket = 0; bucket < kBuckets; ++bucket) {
+                result.counts[p][bucket] += thread_histograms->histograms[p].count(bucket);
+            }
+        }
+    }
+
+    return result;
+}
+
+void report()
+{
+    const auto snap = snapshot();
+
+    for (size_t p = 0; p < kProbeCount; ++p) {
+        const auto& counts = snap.counts[p];
+
+        uint64_t total = 0;
+        for (const auto c : counts) {
+            total += c;
+        }
+
+        std::printf("%-16s %10llu samples  p50<=%llu  p99<=%llu  p99.9<=%llu cycles\n",
+                    probeName(static_cast<Probe>(p)),
+                    static_cast<unsigned long long>(total),
+                    static_cast<unsigned long long>(bucketPercentile(counts, 0.50)),
+                    static_cast<unsigned long long>(bucketPercentile(counts, 0.99)),
+                    static_cast<unsigned long long>(bucketPercentile(counts, 0.999)));
+    }
+}
+
+}  // namespace latency
+
+#endif
@@ -0,0 +1,117 @@
+#pragma once
+
+// Hot-path latency instrumentation, compile-time gated by
+// ORDERBOOK_LATENCY_PROBES (see the CMake option of the same name). When the
+// flag is off every probe macro expands to nothing and the hot path carries
+// zero cost. When on, probes rdtsc-stamp the instrumented regions and
+// accumulate cycle counts into per-thread log2-bucketed histograms that can
+// be snapshotted from any thread without pausing the book.
+
+#ifdef ORDERBOOK_LATENCY_PROBES
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
+namespace latency {
+
+enum class Probe
+{
+    ADD_PATH = 0,       // addImpl entry to trades emitted
+    MATCH_ITERATION,    // one matchTop() execution
+    ADD_LOCK,           // mutex wait in add()
+    CANCEL_LOCK,        // mutex wait in cancel()
+    MODIFY_LOCK,        // mutex wait in modify()
+    COUNT
+};
+
+constexpr size_t kProbeCount = static_cast<size_t>(Probe::COUNT);
+constexpr size_t kBuckets = 64;
+
+inline uint64_t now()
+{
+#if defined(__x86_64__)
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+// Bucket i counts samples whose cycle delta has bit-width i. Increments are
+// relaxed atomics on a thread-local instance, so recording never contends.
+class Histogram
+{
+public:
+    void record(uint64_t cycles)
+    {
+        // Clamped: a delta with bit 63 set (unsynchronized TSCs across a
+        // core migration wrap the subtraction) would index one past the
+        // array; such samples land in the top bucket instead.
+        const auto width = cycles == 0 ? size_t{0} : size_t{64} - static_cast<size_t>(__builtin_clzll(cycles));
+        const auto bucket = std::min(width, kBuckets - 1);
+        m_counts[bucket].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    uint64_t count(size_t bucket) const
+    {
+        return m_counts[bucket].load(std::memory_order_relaxed);
+    }
+
+private:
+    std::array<std::atomic<uint64_t>, kBuckets> m_counts{};
+};
+
+struct Snapshot
+{
+    std::array<std::array<uint64_t, kBuckets>, kProbeCount> counts{};
+};
+
+// Returns this thread's histogram for the probe, registering the thread's
+// set on first use. Registered sets outlive their threads so snapshots keep
+// historical counts.
+Histogram& histogram(Probe probe);
+
+// Sums all registered per-thread histograms. Safe to call concurrently with
+// recording; counts are read with relaxed loads.
+Snapshot snapshot();
+
+// Prints one line per probe with total samples and coarse percentiles
+// (bucket upper bounds, in cycles).
+void report();
+
+class ScopedTimer
+{
+public:
+    explicit ScopedTimer(Probe probe) : m_probe{probe}, m_start{now()} {}
+    ~ScopedTimer() { histogram(m_probe).record(now() - m_start); }
+
+private:
+    Probe m_probe;
+    uint64_t m_start;
+};
+
+}  // namespace latency
+
+// Two-level paste so __LINE__ expands before concatenation; a direct
+// ## would glue the literal token and collide on the second scope in a
+// function.
+#define ORDERBOOK_PROBE_CONCAT_INNER(a, b) a##b
+#define ORDERBOOK_PROBE_CONCAT(a, b) ORDERBOOK_PROBE_CONCAT_INNER(a, b)
+
+#define ORDERBOOK_PROBE_SCOPE(probe) latency::ScopedTimer ORDERBOOK_PROBE_CONCAT(probe_scope_, __LINE__){probe}
+#define ORDERBOOK_PROBE_START(tag) const auto probe_start_##tag = latency::now()
+#define ORDERBOOK_PROBE_STOP(tag, probe) latency::histogram(probe).record(latency::now() - probe_start_##tag)
+
+#else
+
+#define ORDERBOOK_PROBE_SCOPE(probe) ((void)0)
+#define ORDERBOOK_PROBE_START(tag) ((void)0)
+#define ORDERBOOK_PROBE_STOP(tag, probe) ((void)0)
+
+#endif
@@ -0,0 +1,31 @@
+#include "mbp_feed.h"
+
+#include <algorithm>
+
+MbpFeed::MbpFeed(size_t capacity) : m_ring{capacity} {}
+
+void MbpFeed::publish(std::span<const MbpUpdate::Entry> entries)
+{
+    while (!entries.empty()) {
+        const auto take = std::min(entries.size(), MbpUpdate::kMaxEntries);
+
+        MbpUpdate update;
+        update.sequence = ++m_sequence;
+        update.entry_count = static_cast<uint32_t>(take);
+        std::copy_n(entries.begin(), take, update.entries);
+
+        m_ring.publish(update);
+
+        entries = entries.subspan(take);
+    }
+}
+
+MbpFeed::Reader MbpFeed::reader() const
+{
+    return Reader{m_ring};
+}
+
+uint64_t MbpFeed::sequence() const
+{
+    return m_sequence;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "types/book_event.h"
+#include "broadcast_ring.h"
+
+#include <cstdint>
+#include <span>
+
+// One sequence-numbered market-by-price increment: the final state of
+// every level an operation touched, coalesced so a level hit several
+// times inside one add/match cascade appears once.
+struct MbpUpdate
+{
+    static constexpr size_t kMaxEntries = 16;
+
+    struct Entry
+    {
+        Side side{Side::UNKNOWN};
+        Price price{0};
+        Quantity quantity{0};
+        uint32_t count{0};
+    };
+
+    uint64_t sequence{0};
+    uint32_t entry_count{0};
+    Entry entries[kMaxEntries];
+};
+
+// Incremental MBP publication stage. The book flushes each operation's
+// coalesced level deltas here; the feed stamps a gapless sequence per
+// update and broadcasts over the shared reader-paced ring, so downstream
+// publishers forward increments instead of diffing snapshots.
+class MbpFeed
+{
+public:
+    using Reader = BroadcastRing<MbpUpdate>::Reader;
+
+    explicit MbpFeed(size_t capacity);
+
+    // Writer side; single-threaded by contract (the book thread). Entries
+    // beyond kMaxEntries roll into follow-on updates, each sequenced.
+    void publish(std::span<const MbpUpdate::Entry> entries);
+
+    Reader reader() const;
+
+    uint64_t sequence() const;
+
+private:
+    BroadcastRing<MbpUpdate> m_ring;
+    uint64_t m_sequence{0};
+};
@@ -0,0 +1,81 @@
+#include "numa_arena.h"
+
+#include <format>
+#include <stdexcept>
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace {
+
+// Raw mbind so the build needs no libnuma; MPOL_BIND per numaif.h.
+constexpr int kMpolBind = 2;
+
+constexpr size_t kPageSize = 4096;
+
+bool bindToNode(void* addr, size_t length, int node)
+{
+    const unsigned long nodemask = 1ul << node;
+    return ::syscall(SYS_mbind, addr, length, kMpolBind, &nodemask, sizeof(nodemask) * 8, 0) == 0;
+}
+
+}  // namespace
+
+NumaArena::NumaArena(size_t capacity, int node)
+    : m_capacity{(capacity + kPageSize - 1) & ~(kPageSize - 1)}
+    , m_node{node}
+{
+    const auto map = ::mmap(nullptr, m_capacity, PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (map == MAP_FAILED) {
+        throw std::runtime_error(std::format("NumaArena ({} bytes) cannot be mapped.", m_capacity));
+    }
+
+    m_base = static_cast<std::byte*>(map);
+
+    if (node != kAnyNode && !bindToNode(m_base, m_capacity, node)) {
+        ::munmap(m_base, m_capacity);
+        throw std::runtime_error(std::format("NumaArena cannot be bound to node {}.", node));
+    }
+
+    // Prefault after the bind, so each page is placed by policy here and
+    // never faulted from the matching path.
+    for (size_t offset = 0; offset < m_capacity; offset += kPageSize) {
+        m_base[offset] = std::byte{0};
+    }
+}
+
+NumaArena::~NumaArena()
+{
+    if (m_base != nullptr) {
+        ::munmap(m_base, m_capacity);
+    }
+}
+
+void* NumaArena::allocate(size_t bytes, size_t alignment)
+{
+    const auto aligned = (m_used + alignment - 1) & ~(alignment - 1);
+
+    if (aligned + bytes > m_capacity) {
+        throw std::runtime_error(std::format("NumaArena ({} bytes) is exhausted.", m_capacity));
+    }
+
+    m_used = aligned + bytes;
+    return m_base + aligned;
+}
+
+size_t NumaArena::used() const
+{
+    return m_used;
+}
+
+size_t NumaArena::capacity() const
+{
+    return m_capacity;
+}
+
+int NumaArena::node() const
+{
+    return m_node;
+}
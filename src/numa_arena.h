@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+// NUMA-local arena for one book's storage. On multi-socket hosts a book
+// whose pool nodes, hash slots and ladder arrays first-touch on the wrong
+// node pays remote-memory latency on every probe for the rest of the
+// session. The arena maps one region up front, binds it to the requested
+// node and prefaults every page, so any container carved from it is
+// local to the core the book is pinned to by construction instead of by
+// whichever thread happened to fault the heap page first.
+//
+// Allocation is a monotonic bump: frees are no-ops and a container that
+// outgrows its block leaves the old one behind, so size the arena for the
+// book's steady-state working set and reserve containers up front.
+class NumaArena
+{
+public:
+    static constexpr int kAnyNode = -1;
+
+    // Maps and prefaults `capacity` bytes; with a node other than
+    // kAnyNode the region is bound there first, so the prefault places
+    // every page on that node. Throws std::runtime_error when the mapping
+    // or the binding fails.
+    explicit NumaArena(size_t capacity, int node = kAnyNode);
+    ~NumaArena();
+
+    NumaArena(const NumaArena&) = delete;
+    NumaArena& operator=(const NumaArena&) = delete;
+
+    // Throws std::runtime_error when the arena is exhausted.
+    void* allocate(size_t bytes, size_t alignment);
+
+    size_t used() const;
+    size_t capacity() const;
+    int node() const;
+
+private:
+    std::byte* m_base{nullptr};
+    size_t m_capacity{0};
+    size_t m_used{0};
+    int m_node{kAnyNode};
+};
+
+// Standard allocator carving from a NumaArena; with no arena attached it
+// degrades to the global heap, so containers keep one concrete type
+// whether or not placement is controlled. Deallocation through an arena
+// is a no-op (see NumaArena).
+template <class T>
+class ArenaAllocator
+{
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    ArenaAllocator() = default;
+
+    explicit ArenaAllocator(NumaArena* arena)
+        : m_arena{arena}
+    {
+    }
+
+    template <class U>
+    ArenaAllocator(const ArenaAllocator<U>& other)
+        : m_arena{other.arena()}
+    {
+    }
+
+    T* allocate(size_t n)
+    {
+        if (m_arena) {
+            return static_cast<T*>(m_arena->allocate(n * sizeof(T), alignof(T)));
+        }
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, size_t) noexcept
+    {
+        if (!m_arena) {
+            ::operator delete(p);
+        }
+    }
+
+    NumaArena* arena() const { return m_arena; }
+
+private:
+    NumaArena* m_arena{nullptr};
+};
+
+template <class T, class U>
+bool operator==(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs)
+{
+    return lhs.arena() == rhs.arena();
+}
@@ -0,0 +1,126 @@
+#include "order_map.h"
+
+#include <algorithm>
+#include <bit>
+
+OrderMap::OrderMap(size_t expected_orders, NumaArena* arena)
+    : m_slots{ArenaAllocator<Slot>{arena}}
+{
+    // Keep the load factor under 1/2 so linear probe runs stay short.
+    const auto capacity = std::bit_ceil(std::max<size_t>(expected_orders * 2, 16));
+    m_slots.resize(capacity);
+    m_mask = capacity - 1;
+}
+
+size_t OrderMap::slotFor(Order::Id id) const
+{
+    // Fibonacci hashing: dense sequential ids get spread across the table
+    // instead of clustering into one probe run.
+    return static_cast<size_t>(id * 0x9e3779b97f4a7c15ull >> 16) & m_mask;
+}
+
+size_t OrderMap::next(size_t slot) const
+{
+    return (slot + 1) & m_mask;
+}
+
+size_t OrderMap::probeDistance(Order::Id id, size_t slot) const
+{
+    return (slot - slotFor(id)) & m_mask;
+}
+
+bool OrderMap::contains(Order::Id id) const
+{
+    for (auto slot = slotFor(id); m_slots[slot].occupied; slot = next(slot)) {
+        if (m_slots[slot].key == id) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool OrderMap::insert(Order::Id id, OrderPool::Index index)
+{
+    if (m_size * 2 >= m_slots.size()) {
+        grow();
+    }
+
+    auto slot = slotFor(id);
+    for (; m_slots[slot].occupied; slot = next(slot)) {
+        if (m_slots[slot].key == id) {
+            return false;
+        }
+    }
+
+    m_slots[slot] = {.key = id, .value = index, .occupied = true};
+    ++m_size;
+    return true;
+}
+
+OrderPool::Index* OrderMap::find(Order::Id id)
+{
+    for (auto slot = slotFor(id); m_slots[slot].occupied; slot = next(slot)) {
+        if (m_slots[slot].key == id) {
+            return &m_slots[slot].value;
+        }
+    }
+
+    return nullptr;
+}
+
+std::optional<OrderPool::Index> OrderMap::erase(Order::Id id)
+{
+    auto slot = slotFor(id);
+    for (; m_slots[slot].occupied; slot = next(slot)) {
+        if (m_slots[slot].key == id) {
+            break;
+        }
+    }
+
+    if (!m_slots[slot].occupied) {
+        return std::nullopt;
+    }
+
+    const auto index = m_slots[slot].value;
+
+    // Backward-shift deletion: walk the rest of the cluster and pull back
+    // every entry whose home lies at or before the hole, so each surviving
+    // probe sequence stays gap-free without tombstones.
+    auto hole = slot;
+    m_slots[hole] = Slot{};
+    for (auto probe = next(slot); m_slots[probe].occupied; probe = next(probe)) {
+        // Skip entries homed strictly between the hole and the probe slot;
+        // moving those back past their home would break their lookups.
+        if (probeDistance(m_slots[probe].key, probe) < ((probe - hole) & m_mask)) {
+            continue;
+        }
+
+        m_slots[hole] = m_slots[probe];
+        m_slots[probe] = Slot{};
+        hole = probe;
+    }
+    --m_size;
+
+    return index;
+}
+
+size_t OrderMap::size() const
+{
+    return m_size;
+}
+
+void OrderMap::grow()
+{
+    auto old = std::move(m_slots);
+
+    m_slots.assign(old.size() * 2, Slot{});
+    m_mask = m_slots.size() - 1;
+    m_size = 0;
+
+    for (const auto& entry : old) {
+        if (entry.occupied) {
+            insert(entry.key, entry.value);
+        }
+    }
+}
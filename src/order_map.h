@@ -0,0 +1,55 @@
+#pragma once
+
+#include "types/order.h"
+#include "order_pool.h"
+#include "numa_arena.h"
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+// Flat open-addressing map from order id to pool index. Slots live in one
+// contiguous array probed linearly, so a lookup is a single cache-friendly
+// probe sequence instead of a walk over unordered_map's heap-allocated
+// bucket nodes. Deletion uses backward shifting, so there are no tombstones
+// and probe sequences never degrade over a long cancel-heavy session.
+class OrderMap
+{
+public:
+    static constexpr size_t kDefaultCapacity = 1 << 16;
+
+    // With an arena, the slot array is carved from it (and thus
+    // NUMA-local); size the arena so growth stays rare — each doubling
+    // leaves the old array behind in the arena.
+    explicit OrderMap(size_t expected_orders = kDefaultCapacity, NumaArena* arena = nullptr);
+
+    bool contains(Order::Id id) const;
+
+    // Returns false when the id is already present.
+    bool insert(Order::Id id, OrderPool::Index index);
+
+    OrderPool::Index* find(Order::Id id);
+
+    // Removes the id and hands back its pool index in one probe sequence,
+    // for the cancel path where the caller always needs the index next.
+    std::optional<OrderPool::Index> erase(Order::Id id);
+
+    size_t size() const;
+
+private:
+    struct Slot
+    {
+        Order::Id key{0};
+        OrderPool::Index value{OrderPool::kInvalidIndex};
+        bool occupied{false};
+    };
+
+    size_t slotFor(Order::Id id) const;
+    size_t next(size_t slot) const;
+    size_t probeDistance(Order::Id id, size_t slot) const;
+    void grow();
+
+    std::vector<Slot, ArenaAllocator<Slot>> m_slots;
+    size_t m_size{0};
+    size_t m_mask{0};
+};
@@ -0,0 +1,104 @@
+#include "order_pool.h"
+
+OrderPool::OrderPool(size_t capacity, NumaArena* arena)
+    : m_nodes{ArenaAllocator<Node>{arena}}
+{
+    m_nodes.reserve(capacity);
+}
+
+OrderPool::Index OrderPool::allocate(const Order& order)
+{
+    Index index;
+
+    if (m_free_head != kInvalidIndex) {
+        index = m_free_head;
+        m_free_head = m_nodes[index].next;
+    } else {
+        index = static_cast<Index>(m_nodes.size());
+        m_nodes.emplace_back();
+    }
+
+    // Reassigning the whole node must not reset the slot's generation, or
+    // stale handles would start resolving again after reuse.
+    const auto generation = m_nodes[index].generation;
+    m_nodes[index] = Node{.order = order, .generation = generation};
+    ++m_size;
+
+    return index;
+}
+
+void OrderPool::release(Index index)
+{
+    ++m_nodes[index].generation;
+    m_nodes[index].next = m_free_head;
+    m_free_head = index;
+    --m_size;
+}
+
+OrderHandle OrderPool::handleFor(Index index) const
+{
+    return {static_cast<uint64_t>(m_nodes[index].generation) << 32 | index};
+}
+
+OrderPool::Index OrderPool::resolve(OrderHandle handle) const
+{
+    if (!handle.valid()) {
+        return kInvalidIndex;
+    }
+
+    const auto index = static_cast<Index>(handle.value & 0xffffffff);
+    const auto generation = static_cast<uint32_t>(handle.value >> 32);
+
+    if (index >= m_nodes.size() || m_nodes[index].generation != generation) {
+        return kInvalidIndex;
+    }
+
+    return index;
+}
+
+OrderPool::Node& OrderPool::at(Index index)
+{
+    return m_nodes[index];
+}
+
+const OrderPool::Node& OrderPool::at(Index index) const
+{
+    return m_nodes[index];
+}
+
+size_t OrderPool::size() const
+{
+    return m_size;
+}
+
+void OrderQueue::pushBack(OrderPool& pool, OrderPool::Index index)
+{
+    auto& node = pool.at(index);
+    node.prev = tail;
+    node.next = OrderPool::kInvalidIndex;
+
+    if (tail == OrderPool::kInvalidIndex) {
+        head = index;
+    } else {
+        pool.at(tail).next = index;
+    }
+
+    tail = index;
+}
+
+void OrderQueue::erase(OrderPool& pool, OrderPool::Index index)
+{
+    auto& node = pool.at(index);
+
+    if (node.prev != OrderPool::kInvalidIndex) {
+        pool.at(node.prev).next = node.next;
+    } else {
+        head = node.next;
+    }
+
+    if (node.next != OrderPool::kInvalidIndex) {
+        pool.at(node.next).prev = node.prev;
+    } else {
+        tail = node.prev;
+    }
+}
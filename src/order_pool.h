@@ -0,0 +1,80 @@
+#pragma once
+
+#include "types/order.h"
+#include "numa_arena.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Opaque 64-bit reference to a pooled order: low 32 bits the slot index,
+// high 32 bits the slot's generation when the handle was issued. Releasing
+// a slot bumps its generation, so a handle held across the order's removal
+// resolves to nothing instead of whatever order reused the slot.
+struct OrderHandle
+{
+    uint64_t value{UINT64_MAX};
+
+    bool valid() const { return value != UINT64_MAX; }
+};
+
+class OrderPool
+{
+public:
+    using Index = uint32_t;
+
+    static constexpr Index kInvalidIndex = UINT32_MAX;
+    static constexpr size_t kDefaultCapacity = 1024;
+
+    struct Node
+    {
+        Order order{};
+        Index prev{kInvalidIndex};
+        Index next{kInvalidIndex};
+
+        // Links for the book's GFD expiry list, independent of the level
+        // queue links above.
+        Index gfd_prev{kInvalidIndex};
+        Index gfd_next{kInvalidIndex};
+
+        // Bumped on release; stale handles fail the generation check.
+        uint32_t generation{0};
+    };
+
+    // With an arena, node storage is carved from it (and thus NUMA-local);
+    // size the arena so the reserve below never reallocates.
+    explicit OrderPool(size_t capacity = kDefaultCapacity, NumaArena* arena = nullptr);
+
+    Index allocate(const Order& order);
+    void release(Index index);
+
+    // Handle for a live slot, carrying its current generation.
+    OrderHandle handleFor(Index index) const;
+
+    // The slot index a handle refers to, or kInvalidIndex when the slot
+    // was released (and possibly reused) since the handle was issued.
+    Index resolve(OrderHandle handle) const;
+
+    Node& at(Index index);
+    const Node& at(Index index) const;
+
+    size_t size() const;
+
+private:
+    std::vector<Node, ArenaAllocator<Node>> m_nodes;
+    Index m_free_head{kInvalidIndex};
+    size_t m_size{0};
+};
+
+// Intrusive FIFO of pooled orders at a single price level. The queue owns no
+// memory; it links Node::prev/Node::next of nodes living in an OrderPool.
+struct OrderQueue
+{
+    OrderPool::Index head{OrderPool::kInvalidIndex};
+    OrderPool::Index tail{OrderPool::kInvalidIndex};
+
+    bool empty() const { return head == OrderPool::kInvalidIndex; }
+
+    void pushBack(OrderPool& pool, OrderPool::Index index);
+    void erase(OrderPool& pool, OrderPool::Index index);
+};
@@ -0,0 +1,92 @@
+#include "orderbook_engine.h"
+
+OrderbookEngine::OrderbookEngine(size_t queue_capacity)
+    : m_commands{queue_capacity}
+    , m_trades{queue_capacity}
+    , m_match_thread{[this] { run(); }}
+{
+}
+
+OrderbookEngine::~OrderbookEngine()
+{
+    m_shutdown.store(true, std::memory_order_release);
+    m_match_thread.join();
+}
+
+bool OrderbookEngine::submit(const Command& command)
+{
+    return m_commands.tryPush(command);
+}
+
+bool OrderbookEngine::pollTrade(Trade& trade)
+{
+    return m_trades.tryPop(trade);
+}
+
+void OrderbookEngine::run()
+{
+    std::vector<Command> batch;
+    batch.reserve(kDrainBatch);
+
+    while (!m_shutdown.load(std::memory_order_acquire)) {
+        batch.clear();
+
+        Command command;
+        while (batch.size() < kDrainBatch && m_commands.tryPop(command)) {
+            batch.push_back(command);
+        }
+
+        if (batch.empty()) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        std::scoped_lock lock{m_book.m_orders_mutex};
+        for (const auto& cmd : batch) {
+            process(cmd);
+        }
+    }
+}
+
+void OrderbookEngine::process(const Command& command)
+{
+    m_trade_buffer.clear();
+
+    switch (command.kind) {
+    case Command::Kind::ADD:
+        m_book.addImpl(command.order, m_trade_buffer);
+        break;
+    case Command::Kind::CANCEL:
+        m_book.cancelImpl(command.order_id);
+        break;
+    case Command::Kind::MODIFY:
+        m_book.modifyImpl(command.order_id, command.change, m_trade_buffer);
+        break;
+    case Command::Kind::UNKNOWN:
+        break;
+    }
+
+    publish(m_trade_buffer);
+}
+
+void OrderbookEngine::publish(const std::vector<Trade>& trades)
+{
+    for (const auto& trade : trades) {
+        while (!m_trades.tryPush(trade)) {
+            // Completion ring is full: the consumer is behind. Spin rather
+            // than drop fills; backpressure surfaces as matcher stall. On
+            // shutdown nobody will drain the ring again, so spinning would
+            // deadlock the destructor's join — shed and count instead.
+            if (m_shutdown.load(std::memory_order_acquire)) {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                break;
+            }
+            std::this_thread::yield();
+        }
+    }
+}
+
+uint64_t OrderbookEngine::droppedTrades() const
+{
+    return m_dropped.load(std::memory_order_relaxed);
+}
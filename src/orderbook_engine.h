@@ -0,0 +1,50 @@
+#pragma once
+
+#include "orderbook.h"
+#include "ring_buffer.h"
+#include "types/command.h"
+
+#include <atomic>
+#include <thread>
+
+// Single-writer front end for the Orderbook. Gateway threads enqueue
+// commands into a bounded lock-free ring and never touch the book's mutex;
+// a dedicated matching thread drains the ring in batches, takes the book
+// lock once per batch (only to coexist with the GFD prune thread) and runs
+// the add/cancel/modify implementations directly. Trades come back through
+// a completion ring that consumers poll at their own pace.
+class OrderbookEngine
+{
+public:
+    explicit OrderbookEngine(size_t queue_capacity = kDefaultQueueCapacity);
+    ~OrderbookEngine();
+
+    // Returns false when the submission ring is full; the caller decides
+    // whether to retry or shed load.
+    bool submit(const Command& command);
+
+    // Returns false when no trade is pending.
+    bool pollTrade(Trade& trade);
+
+    // Trades shed during shutdown because the completion ring stayed full
+    // with nobody left to drain it.
+    uint64_t droppedTrades() const;
+
+private:
+    void run();
+    void process(const Command& command);
+    void publish(const std::vector<Trade>& trades);
+
+    static constexpr size_t kDefaultQueueCapacity = 1 << 16;
+    static constexpr size_t kDrainBatch = 256;
+
+    Orderbook m_book;
+    RingBuffer<Command> m_commands;
+    RingBuffer<Trade> m_trades;
+    std::vector<Trade> m_trade_buffer;
+
+    std::atomic<uint64_t> m_dropped{0};
+
+    std::thread m_match_thread;
+    std::atomic<bool> m_shutdown{false};
+};
@@ -0,0 +1,141 @@
+#include "orderbook_manager.h"
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace {
+
+void pinToCore(size_t core)
+{
+#ifdef __linux__
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    CPU_SET(core % std::thread::hardware_concurrency(), &cpuset);
+    pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset);
+#else
+    (void)core;
+#endif
+}
+
+}  // namespace
+
+OrderbookManager::OrderbookManager(size_t shard_count, size_t queue_capacity)
+{
+    if (shard_count == 0) {
+        shard_count = 1;
+    }
+
+    m_shards.reserve(shard_count);
+    for (size_t i = 0; i < shard_count; ++i) {
+        m_shards.push_back(std::make_unique<Shard>(queue_capacity));
+    }
+
+    for (size_t i = 0; i < shard_count; ++i) {
+        m_shards[i]->worker = std::thread{[this, i] { run(*m_shards[i], i); }};
+    }
+}
+
+OrderbookManager::~OrderbookManager()
+{
+    m_shutdown.store(true, std::memory_order_release);
+    for (auto& shard : m_shards) {
+        shard->worker.join();
+    }
+}
+
+bool OrderbookManager::submit(Symbol symbol, const Command& command)
+{
+    auto routed = command;
+    routed.symbol = symbol;
+    return shardFor(symbol).commands.tryPush(routed);
+}
+
+bool OrderbookManager::pollTrade(TradeEvent& event)
+{
+    for (size_t i = 0; i < m_shards.size(); ++i) {
+        auto& shard = *m_shards[m_poll_cursor];
+        m_poll_cursor = (m_poll_cursor + 1) % m_shards.size();
+
+        if (shard.trades.tryPop(event)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+std::optional<TopOfBook> OrderbookManager::topOfBook(Symbol symbol) const
+{
+    const auto& shard = shardFor(symbol);
+
+    std::scoped_lock lock{shard.books_mutex};
+    const auto it = shard.books.find(symbol);
+    if (it == shard.books.end()) {
+        return std::nullopt;
+    }
+
+    return it->second->topOfBook();
+}
+
+uint64_t OrderbookManager::droppedTrades() const
+{
+    return m_dropped.load(std::memory_order_relaxed);
+}
+
+Orderbook& OrderbookManager::bookFor(Shard& shard, Symbol symbol)
+{
+    std::scoped_lock lock{shard.books_mutex};
+    auto& book = shard.books[symbol];
+    if (!book) {
+        book = std::make_unique<Orderbook>();
+    }
+    return *book;
+}
+
+void OrderbookManager::run(Shard& shard, size_t shard_index)
+{
+    pinToCore(shard_index);
+
+    std::vector<Trade> trades;
+    trades.reserve(256);
+
+    while (!m_shutdown.load(std::memory_order_acquire)) {
+        Command command;
+        if (!shard.commands.tryPop(command)) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        auto& book = bookFor(shard, command.symbol);
+        trades.clear();
+
+        switch (command.kind) {
+        case Command::Kind::ADD:
+            book.add(command.order, trades);
+            break;
+        case Command::Kind::CANCEL:
+            book.cancel(command.order_id);
+            break;
+        case Command::Kind::MODIFY:
+            book.modify(command.order_id, command.change, trades);
+            break;
+        case Command::Kind::UNKNOWN:
+            break;
+        }
+
+        for (const auto& trade : trades) {
+            while (!shard.trades.tryPush({.symbol = command.symbol, .trade = trade})) {
+                // On shutdown nobody will drain the shard's ring again, so
+                // spinning would deadlock the destructor's join — shed and
+                // count instead.
+                if (m_shutdown.load(std::memory_order_acquire)) {
+                    m_dropped.fetch_add(1, std::memory_order_relaxed);
+                    break;
+                }
+                std::this_thread::yield();
+            }
+        }
+    }
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "orderbook.h"
+#include "ring_buffer.h"
+#include "types/command.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Shards symbols across pinned worker threads so that every Orderbook is
+// touched by exactly one core. Gateway threads route commands to the
+// owning shard's lock-free ring; each worker drains its ring, drives its
+// books, and publishes fills into a per-shard trade ring that pollTrade()
+// merges into one aggregate stream. Quotes are read through the books'
+// wait-free top-of-book snapshots.
+class OrderbookManager
+{
+public:
+    struct TradeEvent
+    {
+        Symbol symbol{0};
+        Trade trade{};
+    };
+
+    explicit OrderbookManager(size_t shard_count = std::thread::hardware_concurrency(),
+                              size_t queue_capacity = kDefaultQueueCapacity);
+    ~OrderbookManager();
+
+    // Returns false when the owning shard's ring is full.
+    bool submit(Symbol symbol, const Command& command);
+
+    // Aggregate trade stream across all shards; single consumer. Returns
+    // false when no trade is pending.
+    bool pollTrade(TradeEvent& event);
+
+    // Wait-free quote read; nullopt for a symbol with no book yet.
+    std::optional<TopOfBook> topOfBook(Symbol symbol) const;
+
+    // Trades shed during shutdown because a shard's trade ring stayed full
+    // with nobody left to drain it.
+    uint64_t droppedTrades() const;
+
+private:
+    struct Shard
+    {
+        explicit Shard(size_t queue_capacity)
+            : commands{queue_capacity}, trades{queue_capacity} {}
+
+        RingBuffer<Command> commands;
+        RingBuffer<TradeEvent> trades;
+
+        // Books are created lazily by the worker; the mutex only guards the
+        // map itself, never a book operation.
+        mutable std::mutex books_mutex;
+        std::unordered_map<Symbol, std::unique_ptr<Orderbook>> books;
+
+        std::thread worker;
+    };
+
+    void run(Shard& shard, size_t shard_index);
+    Orderbook& bookFor(Shard& shard, Symbol symbol);
+    Shard& shardFor(Symbol symbol) { return *m_shards[symbol % m_shards.size()]; }
+    const Shard& shardFor(Symbol symbol) const { return *m_shards[symbol % m_shards.size()]; }
+
+    static constexpr size_t kDefaultQueueCapacity = 1 << 14;
+
+    std::vector<std::unique_ptr<Shard>> m_shards;
+    std::atomic<uint64_t> m_dropped{0};
+    std::atomic<bool> m_shutdown{false};
+    size_t m_poll_cursor{0};
+};
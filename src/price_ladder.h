@@ -0,0 +1,467 @@
+#pragma once
+
+#include "types/common.h"
+#include "types/side.h"
+#include "order_pool.h"
+#include "numa_arena.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+// Price levels for one side of the book. Levels inside a dense band of
+// kBandTicks around the first observed price live in a contiguous array
+// indexed by tick offset, so best-price lookup is O(1) and the matching
+// loop walks sequential memory. Far-away levels fall back to a sorted map.
+//
+// Each level carries its aggregate quantity and order count inline, so
+// FOK admissibility checks and depth queries read the same cache lines
+// the matcher already touched. A Fenwick tree over the band plus a side
+// total keep cumulative quantities incremental, so "how much is resting
+// at or better than this price" is O(log kBandTicks) instead of a walk.
+// WithPrefixSums controls the Fenwick-tree upkeep behind quantityBetterOrEqual;
+// books that never admit FOK orders instantiate the ladder without it and skip
+// that work on every insert, remove and fill.
+template <Side S, bool WithPrefixSums = true>
+class PriceLadder
+{
+    static_assert(S == Side::BUY || S == Side::SELL);
+
+public:
+    static constexpr size_t kBandTicks = 1024;
+
+    struct Level
+    {
+        OrderQueue queue{};
+        Quantity quantity{0};
+        uint32_t count{0};
+    };
+
+    // With an arena, the band array, prefix sums and overflow map nodes
+    // are carved from it (and thus NUMA-local).
+    explicit PriceLadder(NumaArena* arena = nullptr)
+        : m_band(kBandTicks, Level{}, ArenaAllocator<Level>{arena})
+        , m_overflow{Cmp{}, ArenaAllocator<std::pair<const Price, Level>>{arena}}
+        , m_fenwick(WithPrefixSums ? kBandTicks + 1 : 0, 0, ArenaAllocator<Quantity>{arena})
+        , m_fenwick_cost(WithPrefixSums ? kBandTicks + 1 : 0, 0, ArenaAllocator<Cost>{arena})
+    {
+    }
+
+    bool empty() const { return m_levels == 0; }
+
+    // Precondition for bestPrice/bestQueue/worstPrice: !empty().
+    Price bestPrice() const { return m_best; }
+
+    OrderQueue& bestQueue()
+    {
+        return levelAt(m_best).queue;
+    }
+
+    Price worstPrice() const
+    {
+        std::optional<Price> worst;
+
+        if (m_anchored) {
+            Price price = S == Side::BUY ? m_base : m_base + kBandTicks - 1;
+            while (inBand(price)) {
+                if (bandLevel(price).count > 0) {
+                    worst = price;
+                    break;
+                }
+                price += S == Side::BUY ? 1 : -1;
+            }
+        }
+
+        if (!m_overflow.empty()) {
+            const auto overflow_worst = m_overflow.rbegin()->first;
+            if (!worst || better(*worst, overflow_worst)) {
+                worst = overflow_worst;
+            }
+        }
+
+        return *worst;
+    }
+
+    void insert(OrderPool& pool, Price price, OrderPool::Index index)
+    {
+        auto& level = levelFor(price);
+        const bool was_empty = level.count == 0;
+
+        level.queue.pushBack(pool, index);
+        level.quantity += pool.at(index).order.remainder;
+        ++level.count;
+        applyQuantityDelta(price, static_cast<int64_t>(pool.at(index).order.remainder));
+
+        if (was_empty) {
+            ++m_levels;
+            if (m_levels == 1 || better(price, m_best)) {
+                m_best = price;
+            }
+        }
+    }
+
+    void remove(OrderPool& pool, Price price, OrderPool::Index index)
+    {
+        auto& level = levelAt(price);
+
+        level.queue.erase(pool, index);
+        level.quantity -= pool.at(index).order.remainder;
+        --level.count;
+        applyQuantityDelta(price, -static_cast<int64_t>(pool.at(index).order.remainder));
+
+        if (level.count > 0) {
+            return;
+        }
+
+        if (!inBand(price)) {
+            m_overflow.erase(price);
+        }
+
+        --m_levels;
+
+        if (m_levels == 0) {
+            m_anchored = false;
+        } else if (price == m_best) {
+            recomputeBest(price);
+        }
+    }
+
+    // Takes matched quantity off a level's aggregate after an order at that
+    // level was partially or fully filled.
+    void reduce(Price price, Quantity quantity)
+    {
+        levelAt(price).quantity -= quantity;
+        applyQuantityDelta(price, -static_cast<int64_t>(quantity));
+    }
+
+    // Puts replenished quantity back onto a level's aggregate when an
+    // iceberg rolls reserve into its visible remainder.
+    void increase(Price price, Quantity quantity)
+    {
+        levelAt(price).quantity += quantity;
+        applyQuantityDelta(price, static_cast<int64_t>(quantity));
+    }
+
+    // Point query of one level's aggregate, for event publication after a
+    // change; all zeros when nothing rests at the price.
+    Level levelOrEmpty(Price price) const
+    {
+        if (inBand(price)) {
+            return bandLevel(price);
+        }
+
+        const auto it = m_overflow.find(price);
+        return it == m_overflow.end() ? Level{} : it->second;
+    }
+
+    Quantity totalQuantity() const { return m_total; }
+
+    // Cumulative resting quantity at prices equal to or better than limit.
+    // Band levels are answered from the Fenwick tree; far-away overflow
+    // levels (rare) are summed directly.
+    Quantity quantityBetterOrEqual(Price limit) const
+    {
+        Quantity sum = 0;
+
+        for (const auto& [price, level] : m_overflow) {
+            if (better(limit, price)) {
+                break;
+            }
+            sum += level.quantity;
+        }
+
+        if (m_anchored) {
+            sum += bandQuantityBetterOrEqual(limit);
+        }
+
+        return sum;
+    }
+
+    // Price-weighted cost of sweeping `target` quantity off this side in
+    // priority order, partial quantity priced at the marginal level.
+    // Band levels are answered in O(log kBandTicks) from the prefix sums;
+    // far-away overflow levels (rare) are consumed directly. Returns
+    // nullopt when less than `target` rests on the side.
+    std::optional<Cost> sweepCost(Quantity target) const
+    {
+        static_assert(WithPrefixSums, "sweepCost needs the ladder's prefix sums");
+
+        if (target == 0) {
+            return 0;
+        }
+
+        if (m_total < target) {
+            return std::nullopt;
+        }
+
+        Cost cost = 0;
+        Quantity remaining = target;
+        size_t ticks_done = 0;  // best-first band ticks fully consumed
+
+        // Consumes band ticks best-first up to the `limit` best ones.
+        const auto consumeBand = [&](size_t limit) {
+            if (!m_anchored || limit <= ticks_done || remaining == 0) {
+                return;
+            }
+
+            const auto base_qty = bandCum(ticks_done);
+            const auto base_cost = bandCostCum(ticks_done);
+            const auto available = bandCum(limit) - base_qty;
+
+            if (available < remaining) {
+                cost += bandCostCum(limit) - base_cost;
+                remaining -= available;
+                ticks_done = limit;
+                return;
+            }
+
+            // Smallest best-tick count whose cumulative covers the rest.
+            size_t lo = ticks_done + 1;
+            size_t hi = limit;
+            while (lo < hi) {
+                const auto mid = (lo + hi) / 2;
+                if (bandCum(mid) - base_qty >= remaining) {
+                    hi = mid;
+                } else {
+                    lo = mid + 1;
+                }
+            }
+
+            const auto before = bandCum(lo - 1) - base_qty;
+            cost += bandCostCum(lo - 1) - base_cost;
+            cost += static_cast<Cost>(remaining - before) * tickPrice(lo - 1);
+            remaining = 0;
+            ticks_done = lo;
+        };
+
+        for (auto it = m_overflow.begin(); remaining > 0 && it != m_overflow.end(); ++it) {
+            consumeBand(ticksBetterThan(it->first));
+
+            if (remaining == 0) {
+                break;
+            }
+
+            const auto take = std::min(it->second.quantity, remaining);
+            cost += static_cast<Cost>(take) * it->first;
+            remaining -= take;
+        }
+
+        if (remaining > 0) {
+            consumeBand(kBandTicks);
+        }
+
+        return cost;
+    }
+
+    // Visits levels in priority order (best first). The callback returns
+    // false to stop early.
+    template <class F>
+    void forEachLevel(F&& f) const
+    {
+        auto it = m_overflow.begin();
+
+        if (m_anchored) {
+            const Price best_edge = S == Side::BUY ? m_base + kBandTicks - 1 : m_base;
+
+            while (it != m_overflow.end() && better(it->first, best_edge)) {
+                if (!f(it->first, it->second)) {
+                    return;
+                }
+                ++it;
+            }
+
+            Price price = best_edge;
+            while (inBand(price)) {
+                const auto& level = bandLevel(price);
+                if (level.count > 0 && !f(price, level)) {
+                    return;
+                }
+                price += S == Side::BUY ? -1 : 1;
+            }
+        }
+
+        for (; it != m_overflow.end(); ++it) {
+            if (!f(it->first, it->second)) {
+                return;
+            }
+        }
+    }
+
+private:
+    static bool better(Price lhs, Price rhs)
+    {
+        return S == Side::BUY ? lhs > rhs : lhs < rhs;
+    }
+
+    bool inBand(Price price) const
+    {
+        return m_anchored && price >= m_base && price < m_base + static_cast<Price>(kBandTicks);
+    }
+
+    Level& bandLevel(Price price) { return m_band[price - m_base]; }
+    const Level& bandLevel(Price price) const { return m_band[price - m_base]; }
+
+    Level& levelAt(Price price)
+    {
+        return inBand(price) ? bandLevel(price) : m_overflow.at(price);
+    }
+
+    Level& levelFor(Price price)
+    {
+        if (!m_anchored) {
+            m_base = price - static_cast<Price>(kBandTicks / 2);
+            m_anchored = true;
+        }
+
+        return inBand(price) ? bandLevel(price) : m_overflow[price];
+    }
+
+    void applyQuantityDelta(Price price, int64_t delta)
+    {
+        m_total = static_cast<Quantity>(static_cast<int64_t>(m_total) + delta);
+
+        if constexpr (WithPrefixSums) {
+            if (inBand(price)) {
+                fenwickAdd(static_cast<size_t>(price - m_base), delta);
+                fenwickCostAdd(static_cast<size_t>(price - m_base), delta * price);
+                m_band_total = static_cast<Quantity>(static_cast<int64_t>(m_band_total) + delta);
+                m_band_cost += delta * price;
+            }
+        }
+    }
+
+    // Quantity and cost resting on the `i` best band ticks; for bids the
+    // best ticks are the top of the array, so the prefix is flipped.
+    Quantity bandCum(size_t i) const
+    {
+        if constexpr (S == Side::SELL) {
+            return i == 0 ? 0 : fenwickPrefix(i - 1);
+        } else {
+            return m_band_total - (i == kBandTicks ? 0 : fenwickPrefix(kBandTicks - i - 1));
+        }
+    }
+
+    Cost bandCostCum(size_t i) const
+    {
+        if constexpr (S == Side::SELL) {
+            return i == 0 ? 0 : fenwickCostPrefix(i - 1);
+        } else {
+            return m_band_cost - (i == kBandTicks ? 0 : fenwickCostPrefix(kBandTicks - i - 1));
+        }
+    }
+
+    // Number of band ticks at strictly better prices than p, clamped.
+    size_t ticksBetterThan(Price p) const
+    {
+        if (!m_anchored) {
+            return 0;
+        }
+
+        const int64_t raw = S == Side::SELL ? p - m_base : m_base + static_cast<Price>(kBandTicks) - 1 - p;
+        return static_cast<size_t>(std::clamp<int64_t>(raw, 0, kBandTicks));
+    }
+
+    // Price of the i-th best band tick (0-based).
+    Price tickPrice(size_t i) const
+    {
+        return S == Side::SELL ? m_base + static_cast<Price>(i) : m_base + static_cast<Price>(kBandTicks - 1 - i);
+    }
+
+    void fenwickAdd(size_t index, int64_t delta)
+    {
+        for (size_t i = index + 1; i <= kBandTicks; i += i & (~i + 1)) {
+            m_fenwick[i] = static_cast<Quantity>(static_cast<int64_t>(m_fenwick[i]) + delta);
+        }
+    }
+
+    Quantity fenwickPrefix(size_t index) const
+    {
+        Quantity sum = 0;
+        for (size_t i = index + 1; i > 0; i -= i & (~i + 1)) {
+            sum += m_fenwick[i];
+        }
+        return sum;
+    }
+
+    void fenwickCostAdd(size_t index, Cost delta)
+    {
+        for (size_t i = index + 1; i <= kBandTicks; i += i & (~i + 1)) {
+            m_fenwick_cost[i] += delta;
+        }
+    }
+
+    Cost fenwickCostPrefix(size_t index) const
+    {
+        Cost sum = 0;
+        for (size_t i = index + 1; i > 0; i -= i & (~i + 1)) {
+            sum += m_fenwick_cost[i];
+        }
+        return sum;
+    }
+
+    Quantity bandQuantityBetterOrEqual(Price limit) const
+    {
+        const Price lo = m_base;
+        const Price hi = m_base + static_cast<Price>(kBandTicks) - 1;
+
+        if constexpr (S == Side::SELL) {
+            if (limit < lo) {
+                return 0;
+            }
+            return fenwickPrefix(static_cast<size_t>(std::min(limit, hi) - lo));
+        } else {
+            if (limit > hi) {
+                return 0;
+            }
+            const Price from = std::max(limit, lo);
+            return m_band_total - (from > lo ? fenwickPrefix(static_cast<size_t>(from - 1 - lo)) : 0);
+        }
+    }
+
+    void recomputeBest(Price from)
+    {
+        std::optional<Price> band_best;
+
+        if (m_anchored) {
+            Price price = inBand(from) ? from : (S == Side::BUY ? m_base + kBandTicks - 1 : m_base);
+            while (inBand(price)) {
+                if (bandLevel(price).count > 0) {
+                    band_best = price;
+                    break;
+                }
+                price += S == Side::BUY ? -1 : 1;
+            }
+        }
+
+        if (!m_overflow.empty()) {
+            const auto overflow_best = m_overflow.begin()->first;
+            if (!band_best || better(overflow_best, *band_best)) {
+                m_best = overflow_best;
+                return;
+            }
+        }
+
+        m_best = *band_best;
+    }
+
+private:
+    using Cmp = std::conditional_t<S == Side::BUY, std::greater<Price>, std::less<Price>>;
+
+    std::vector<Level, ArenaAllocator<Level>> m_band;
+    Price m_base{0};
+    bool m_anchored{false};
+
+    std::map<Price, Level, Cmp, ArenaAllocator<std::pair<const Price, Level>>> m_overflow;
+
+    std::vector<Quantity, ArenaAllocator<Quantity>> m_fenwick;
+    std::vector<Cost, ArenaAllocator<Cost>> m_fenwick_cost;
+    Cost m_band_cost{0};
+    Quantity m_total{0};
+    Quantity m_band_total{0};
+
+    Price m_best{0};
+    size_t m_levels{0};
+};
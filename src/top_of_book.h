@@ -0,0 +1,68 @@
+#pragma once
+
+#include "types/common.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+struct TopOfBook
+{
+    static constexpr size_t kDepth = 8;
+
+    struct Level
+    {
+        Price price{0};
+        Quantity quantity{0};
+        uint32_t count{0};
+    };
+
+    std::array<Level, kDepth> bids{};
+    std::array<Level, kDepth> asks{};
+    size_t bid_depth{0};
+    size_t ask_depth{0};
+};
+
+// Single-writer seqlock around a TopOfBook snapshot. The matching thread
+// publishes after every book mutation; readers spin only across a torn
+// read (a concurrent publish) and never block the writer.
+class TopOfBookCache
+{
+public:
+    void publish(const TopOfBook& top)
+    {
+        const auto seq = m_sequence.load(std::memory_order_relaxed) + 1;
+        m_sequence.store(seq, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        m_snapshot = top;
+
+        std::atomic_thread_fence(std::memory_order_release);
+        m_sequence.store(seq + 1, std::memory_order_relaxed);
+    }
+
+    TopOfBook read() const
+    {
+        TopOfBook top;
+
+        while (true) {
+            const auto before = m_sequence.load(std::memory_order_acquire);
+            if (before & 1) {
+                continue;
+            }
+
+            top = m_snapshot;
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            const auto after = m_sequence.load(std::memory_order_relaxed);
+            if (before == after) {
+                return top;
+            }
+        }
+    }
+
+private:
+    std::atomic<uint64_t> m_sequence{0};
+    TopOfBook m_snapshot{};
+};
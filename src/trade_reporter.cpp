@@ -0,0 +1,59 @@
+#include "trade_reporter.h"
+
+#include <utility>
+
+TradeReporter::TradeReporter(size_t capacity, Sink sink)
+    : m_queue{capacity}
+    , m_sink{std::move(sink)}
+    , m_thread{[this] { run(); }}
+{
+}
+
+TradeReporter::~TradeReporter()
+{
+    m_shutdown.store(true, std::memory_order_release);
+    m_thread.join();
+}
+
+bool TradeReporter::submit(const Trade& trade)
+{
+    if (!m_queue.tryPush(trade)) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    return true;
+}
+
+uint64_t TradeReporter::dropped() const
+{
+    return m_dropped.load(std::memory_order_relaxed);
+}
+
+void TradeReporter::run()
+{
+    Trade trade;
+
+    while (true) {
+        bool drained_any = false;
+
+        while (m_queue.tryPop(trade)) {
+            drained_any = true;
+            m_sink(trade);
+        }
+
+        if (!drained_any) {
+            if (m_shutdown.load(std::memory_order_acquire)) {
+                // One more pass after observing shutdown: submits that
+                // raced the empty drain above land before the store and
+                // are visible now, so every submitted trade is reported.
+                while (m_queue.tryPop(trade)) {
+                    m_sink(trade);
+                }
+                return;
+            }
+
+            std::this_thread::yield();
+        }
+    }
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "types/trade.h"
+#include "ring_buffer.h"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <thread>
+
+// Asynchronous fill-reporting stage. The matching path hands each trade
+// off with one lock-free ring write and returns; a dedicated reporter
+// thread drains the ring in batches into a preallocated buffer and runs
+// the sink (serialization, network send, ...) entirely off the add
+// latency path. The matcher is never blocked: if the ring is full the
+// trade is counted as dropped rather than stalling the book.
+class TradeReporter
+{
+public:
+    using Sink = std::function<void(const Trade&)>;
+
+    TradeReporter(size_t capacity, Sink sink);
+    ~TradeReporter();
+
+    TradeReporter(const TradeReporter&) = delete;
+    TradeReporter& operator=(const TradeReporter&) = delete;
+
+    // Lock-free handoff; returns false (and counts a drop) when the
+    // reporter has fallen a full ring behind.
+    bool submit(const Trade& trade);
+
+    uint64_t dropped() const;
+
+private:
+    void run();
+
+    RingBuffer<Trade> m_queue;
+    Sink m_sink;
+    std::atomic<uint64_t> m_dropped{0};
+    std::atomic<bool> m_shutdown{false};
+
+    // Must be the last member: the reporter thread uses the queue and
+    // shutdown flag from the moment it starts.
+    std::thread m_thread;
+};
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "common.h"
+#include "side.h"
+#include "trade.h"
+
+// One record on the broadcast event stream: either an executed trade or
+// the new aggregate of a price level that just changed.
+struct BookEvent
+{
+    enum class Kind
+    {
+        UNKNOWN = 0,
+        TRADE = 1,
+        LEVEL_UPDATE = 2
+    };
+
+    Kind kind{Kind::UNKNOWN};
+
+    // TRADE
+    Trade trade{};
+
+    // LEVEL_UPDATE; quantity and count are the level's state after the
+    // change, zero when the level emptied.
+    Side side{Side::UNKNOWN};
+    Price price{0};
+    Quantity quantity{0};
+    uint32_t count{0};
+};
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "order.h"
+#include "change.h"
+
+struct Command
+{
+    enum class Kind
+    {
+        UNKNOWN = 0,
+        ADD = 1,
+        CANCEL = 2,
+        MODIFY = 3
+    };
+
+    Kind kind{Kind::UNKNOWN};
+    Symbol symbol{0};
+    Order order{};
+    Order::Id order_id{0};
+    Change change{};
+};
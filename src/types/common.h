@@ -4,3 +4,6 @@
 
 using Quantity = uint64_t;
 using Price = int64_t;
+using Symbol = uint32_t;
+using Cost = int64_t;
+using Participant = uint32_t;
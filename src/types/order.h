@@ -12,16 +12,31 @@ struct Order
 	    FAK = 2,
 	    FOK = 3,
 	    GFD = 4,
-	    MAR = 5
+	    MAR = 5,
+	    ICEBERG = 6,
+	    STOP = 7,
+	    STOP_LIMIT = 8
     };
 
     using Id = uint64_t;
 
     Id id{0};
+    // Owning firm, for self-match prevention; 0 means unattributed.
+    Participant participant{0};
     Type type{Type::UNKNOWN};
     Quantity remainder{0};
+    // Iceberg only: peak visible size and the reserve still hidden from the
+    // book. remainder always holds just the visible portion.
+    Quantity display{0};
+    Quantity hidden{0};
     Side side{Side::UNKNOWN};
     Price price{0};
+    // STOP/STOP_LIMIT only: the print that arms the order. STOP enters the
+    // book as a market order once triggered, STOP_LIMIT as GTC at price.
+    Price stop_price{0};
+    // Admission time (steady_clock ns), stamped by the book when zero;
+    // journaled and snapshotted records keep their original stamp.
+    uint64_t arrival_ns{0};
 
     void fill(Quantity quantity);
     bool filled() const;
@@ -1,10 +1,18 @@
 #pragma once
 
 #include "common.h"
+#include "order.h"
+
+#include <cstdint>
 
 struct TradeInfo
 {
     Order::Id order_id{0};
     Price price{0};
     Quantity quantity{0};
+    // Execution-quality telemetry, captured inline by the matcher: how
+    // long this leg rested before the fill, and whether it was the order
+    // whose entry caused the match.
+    uint64_t resting_ns{0};
+    bool aggressor{false};
 };